@@ -3,11 +3,18 @@
 
 #include <vector>
 #include <string>
+#include <limits>
 
 #include "base/type.h"
 
 namespace Ramulator {
 
+/**
+ * @brief    Next event clock reported by a clocked object that has nothing scheduled.
+ *
+ */
+inline constexpr Clk_t no_event_clk = std::numeric_limits<Clk_t>::max();
+
 /**
  * @brief    CRTP interface for all clocked objects (i.e., can be ticked)
  * 
@@ -22,6 +29,7 @@ class Clocked {
 
   public:
     virtual void tick() = 0;
+    Clk_t get_clk() const { return m_clk; };
 
   public:
     Clocked() {};
@@ -2,8 +2,11 @@
 #define     RAMULATOR_BASE_REQUEST_H
 
 #include <vector>
-#include <list>
+#include <deque>
+#include <unordered_map>
 #include <string>
+#include <iterator>
+#include <stdexcept>
 
 #include "base/base.h"
 
@@ -24,11 +27,13 @@ struct Request {
 
   int type_id = -1;    // An identifier for the type of the request
   int source_id = -1;  // An identifier for where the request is coming from (e.g., which core)
+  int qos_class = 0;   // The QoS class of the request (a higher class has a higher priority with the QoS scheduler)
 
   int command = -1;          // The command that need to be issued to progress the request
   int final_command = -1;    // The final command that is needed to finish the request
 
   Clk_t arrive = -1;   // Clock cycle when the request arrive at the memory controller
+  Clk_t issue = -1;    // Clock cycle when the first command of the request is issued
   Clk_t depart = -1;   // Clock cycle when the request depart the memory controller
 
   std::function<void(Request&)> callback;
@@ -39,30 +44,230 @@ struct Request {
 };
 
 
+/**
+ * @brief    A fixed-capacity request buffer backed by a pool of request slots
+ * @details
+ * Each request is stored in a slot that is created the first time the buffer grows to it and then recycled
+ * through an intrusive free list, so a warmed-up buffer enqueues and removes requests without touching the
+ * allocator. The buffered requests are kept in arrival order with an intrusive doubly-linked list. Slots never
+ * move, so an iterator (i.e., the slot index) stays a valid handle to its request until the request is removed.
+ * 
+ * The buffer can optionally index its requests by the row they access (i.e., the flat bank id and the row id).
+ * Requests to the same row share the same prerequisite command and readiness, so a scheduler only needs to look
+ * at the oldest request of every row queue.
+ * 
+ */
 struct ReqBuffer {
-  std::list<Request> buffer;
+  struct Slot {
+    Request req;
+    int prev = -1;
+    int next = -1;
+    size_t seq = 0;         // Enqueue order
+    int row_queue = -1;
+    int row_prev = -1;
+    int row_next = -1;
+  };
+
+  struct RowQueue {
+    Addr_t row_key = -1;
+    int head = -1;
+    int tail = -1;
+    int pos = -1;           // Position in active_row_queues
+
+    // Scheduling information cached by the scheduler (reset whenever the queue is reused for another row)
+    int command = -1;                 // The prerequisite command of the row
+    uint64_t state_version = 0;       // The state version of the row when the command was cached
+    Clk_t earliest_issue_clk = -1;    // The command cannot be issued before this cycle
+  };
+
+  std::deque<Slot> slots;   // The slot pool (std::deque does not relocate existing slots when growing)
+  int head = -1;            // Oldest buffered request
+  int tail = -1;            // Youngest buffered request
+  int free_head = -1;       // First slot in the free list (linked through Slot::next)
+  size_t num_reqs = 0;
   size_t max_size = 32;
+  size_t next_seq = 0;
+
+  std::vector<int> row_key_level_sizes;   // Sizes of the levels that form the row key (empty if the buffer is not indexed)
+  std::vector<RowQueue> row_queues;       // The row queue pool
+  std::vector<int> free_row_queues;
+  std::vector<int> active_row_queues;     // Non-empty row queues (in no particular order)
+  std::unordered_map<Addr_t, int> row_queue_ids;   // Row key -> id of its (non-empty) row queue
+
+
+  class iterator {
+    friend struct ReqBuffer;
+    private:
+      ReqBuffer* m_buffer = nullptr;
+      int m_slot = -1;
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = Request;
+      using difference_type = std::ptrdiff_t;
+      using pointer = Request*;
+      using reference = Request&;
+
+      iterator() = default;
+      iterator(ReqBuffer* buffer, int slot): m_buffer(buffer), m_slot(slot) {};
+
+      Request& operator*() const { return m_buffer->slots[m_slot].req; };
+      Request* operator->() const { return &m_buffer->slots[m_slot].req; };
+      iterator& operator++() { m_slot = m_buffer->slots[m_slot].next; return *this; };
+      iterator operator++(int) { iterator it = *this; ++(*this); return it; };
+      bool operator==(const iterator& other) const { return m_buffer == other.m_buffer && m_slot == other.m_slot; };
+      bool operator!=(const iterator& other) const { return !(*this == other); };
+
+      // The enqueue order of the request (i.e., its position in the buffer relative to the other requests)
+      size_t seq() const { return m_buffer->slots[m_slot].seq; };
+  };
+
+  iterator begin() { return iterator(this, head); };
+  iterator end() { return iterator(this, -1); };
 
 
-  using iterator = std::list<Request>::iterator;
-  iterator begin() { return buffer.begin(); };
-  iterator end() { return buffer.end(); };
+  size_t size() const { return num_reqs; }
+
+  /**
+   * @brief    Indexes the requests by their address vector up to the row level (level_sizes gives the size of each of these levels)
+   * 
+   */
+  void index_by_row(const std::vector<int>& level_sizes) {
+    if (num_reqs) {
+      throw std::runtime_error("Cannot index a non-empty request buffer!");
+    }
+    row_key_level_sizes = level_sizes;
+  }
 
+  bool is_row_indexed() const { return row_key_level_sizes.size(); }
 
-  size_t size() const { return buffer.size(); }
+  // The oldest request of a row queue
+  iterator row_queue_head(int queue_id) { return iterator(this, row_queues[queue_id].head); }
+
+  // The next (younger) request in the row queue of a request (end() if it is the youngest one)
+  iterator row_queue_next(iterator it) { return iterator(this, slots[it.m_slot].row_next); }
 
   bool enqueue(const Request& request) {
-    if (buffer.size() <= max_size) {
-      buffer.push_back(request);
-      return true;
-    } else {
+    return enqueue(Request(request));
+  }
+
+  bool enqueue(Request&& request) {
+    if (num_reqs > max_size) {
       return false;
     }
+
+    int slot_id = free_head;
+    if (slot_id == -1) {
+      slot_id = slots.size();
+      slots.push_back(Slot{std::move(request)});
+    } else {
+      free_head = slots[slot_id].next;
+      slots[slot_id].req = std::move(request);
+    }
+
+    Slot& slot = slots[slot_id];
+    slot.prev = tail;
+    slot.next = -1;
+    if (tail == -1) {
+      head = slot_id;
+    } else {
+      slots[tail].next = slot_id;
+    }
+    tail = slot_id;
+    slot.seq = next_seq++;
+    num_reqs++;
+
+    if (is_row_indexed()) {
+      link_row_queue(slot_id);
+    }
+    return true;
   }
 
   void remove(iterator it) {
-    buffer.erase(it);
+    int slot_id = it.m_slot;
+    Slot& slot = slots[slot_id];
+    if (slot.prev == -1) {
+      head = slot.next;
+    } else {
+      slots[slot.prev].next = slot.next;
+    }
+    if (slot.next == -1) {
+      tail = slot.prev;
+    } else {
+      slots[slot.next].prev = slot.prev;
+    }
+
+    if (is_row_indexed()) {
+      unlink_row_queue(slot_id);
+    }
+
+    // Do not keep whatever the callback captured alive while the slot sits in the free list
+    slot.req.callback = nullptr;
+    slot.prev = -1;
+    slot.next = free_head;
+    free_head = slot_id;
+    num_reqs--;
   }
+
+  private:
+    void link_row_queue(int slot_id) {
+      Slot& slot = slots[slot_id];
+      Addr_t row_key = 0;
+      for (int level = 0; level < row_key_level_sizes.size(); level++) {
+        row_key = row_key * row_key_level_sizes[level] + slot.req.addr_vec[level];
+      }
+
+      auto [id_it, is_new_row] = row_queue_ids.try_emplace(row_key, -1);
+      int& queue_id = id_it->second;
+      if (is_new_row) {
+        if (free_row_queues.size()) {
+          queue_id = free_row_queues.back();
+          free_row_queues.pop_back();
+        } else {
+          queue_id = row_queues.size();
+          row_queues.emplace_back();
+        }
+        row_queues[queue_id] = {row_key, -1, -1, (int) active_row_queues.size()};
+        active_row_queues.push_back(queue_id);
+      }
+
+      RowQueue& queue = row_queues[queue_id];
+      slot.row_queue = queue_id;
+      slot.row_prev = queue.tail;
+      slot.row_next = -1;
+      if (queue.tail == -1) {
+        queue.head = slot_id;
+      } else {
+        slots[queue.tail].row_next = slot_id;
+      }
+      queue.tail = slot_id;
+    }
+
+    void unlink_row_queue(int slot_id) {
+      Slot& slot = slots[slot_id];
+      RowQueue& queue = row_queues[slot.row_queue];
+      if (slot.row_prev == -1) {
+        queue.head = slot.row_next;
+      } else {
+        slots[slot.row_prev].row_next = slot.row_next;
+      }
+      if (slot.row_next == -1) {
+        queue.tail = slot.row_prev;
+      } else {
+        slots[slot.row_next].row_prev = slot.row_prev;
+      }
+
+      if (queue.head == -1) {
+        // Swap the last active queue into the position of the now empty one
+        int last_id = active_row_queues.back();
+        active_row_queues[queue.pos] = last_id;
+        row_queues[last_id].pos = queue.pos;
+        active_row_queues.pop_back();
+        free_row_queues.push_back(slot.row_queue);
+        row_queue_ids.erase(queue.row_key);
+      }
+      slot.row_queue = -1;
+    }
 };
 
 }        // namespace Ramulator
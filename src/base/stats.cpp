@@ -1,3 +1,7 @@
+#include <bit>
+#include <algorithm>
+#include <cmath>
+
 #include "base/stats.h"
 
 namespace Ramulator {
@@ -9,4 +13,76 @@ YAML::Emitter& operator << (YAML::Emitter& emitter, const Stats& s) {
 	return emitter;
 }
 
+void LatencyHistogram::add(Clk_t latency) {
+  latency = std::max<Clk_t>(latency, 0);
+  size_t bucket = bucket_of(latency);
+  if (bucket >= m_buckets.size()) {
+    m_buckets.resize(bucket + 1, 0);
+  }
+  m_buckets[bucket]++;
+  m_count++;
+  m_sum += latency;
+  m_max = std::max(m_max, latency);
+}
+
+Clk_t LatencyHistogram::percentile(double p) const {
+  if (m_count == 0) {
+    return 0;
+  }
+  uint64_t rank = std::max<uint64_t>(1, (uint64_t) std::ceil(p * m_count));
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < m_buckets.size(); bucket++) {
+    seen += m_buckets[bucket];
+    if (seen >= rank) {
+      return std::min(bucket_upper_bound(bucket), m_max);
+    }
+  }
+  return m_max;
+}
+
+size_t LatencyHistogram::bucket_of(Clk_t latency) {
+  constexpr Clk_t num_sub_buckets = 1 << sub_bucket_bits;
+  if (latency < num_sub_buckets) {
+    return latency;
+  }
+  int msb = std::bit_width((uint64_t) latency) - 1;
+  int shift = msb - sub_bucket_bits;
+  return (msb - sub_bucket_bits + 1) * num_sub_buckets + ((latency >> shift) & (num_sub_buckets - 1));
+}
+
+Clk_t LatencyHistogram::bucket_lower_bound(size_t bucket) {
+  constexpr Clk_t num_sub_buckets = 1 << sub_bucket_bits;
+  if (bucket < num_sub_buckets) {
+    return bucket;
+  }
+  int shift = bucket / num_sub_buckets - 1;
+  return (num_sub_buckets + bucket % num_sub_buckets) << shift;
+}
+
+Clk_t LatencyHistogram::bucket_upper_bound(size_t bucket) {
+  return bucket_lower_bound(bucket + 1) - 1;
+}
+
+YAML::Emitter& operator << (YAML::Emitter& emitter, const LatencyHistogram& h) {
+  emitter << YAML::BeginMap;
+  emitter << YAML::Key << "count" << YAML::Value << h.m_count;
+  if (h.m_count) {
+    emitter << YAML::Key << "mean" << YAML::Value << h.mean();
+    emitter << YAML::Key << "p50" << YAML::Value << h.percentile(0.5);
+    emitter << YAML::Key << "p99" << YAML::Value << h.percentile(0.99);
+    emitter << YAML::Key << "p99.9" << YAML::Value << h.percentile(0.999);
+    emitter << YAML::Key << "max" << YAML::Value << h.m_max;
+    // Only the non-empty buckets (keyed by their lower bound)
+    emitter << YAML::Key << "buckets" << YAML::Value << YAML::Flow << YAML::BeginMap;
+    for (size_t bucket = 0; bucket < h.m_buckets.size(); bucket++) {
+      if (h.m_buckets[bucket]) {
+        emitter << YAML::Key << LatencyHistogram::bucket_lower_bound(bucket) << YAML::Value << h.m_buckets[bucket];
+      }
+    }
+    emitter << YAML::EndMap;
+  }
+  emitter << YAML::EndMap;
+  return emitter;
+}
+
 }        // namespace Ramulator
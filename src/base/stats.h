@@ -14,6 +14,44 @@
 
 namespace Ramulator {
 
+/**
+ * @brief    A log-bucketed histogram of latencies (in cycles)
+ * @details
+ * Latencies below 2^sub_bucket_bits are counted exactly. Every larger power-of-two range is split into
+ * 2^sub_bucket_bits equally sized buckets, so a percentile is off by at most 1/2^sub_bucket_bits of its value
+ * while the histogram only needs a few hundred counters for any latency.
+ * 
+ */
+class LatencyHistogram {
+  public:
+    static constexpr int sub_bucket_bits = 3;
+
+  private:
+    std::vector<uint64_t> m_buckets;
+    uint64_t m_count = 0;
+    Clk_t m_sum = 0;
+    Clk_t m_max = 0;
+
+  public:
+    void add(Clk_t latency);
+
+    uint64_t count() const { return m_count; };
+    Clk_t max() const { return m_max; };
+    double mean() const { return m_count ? (double) m_sum / m_count : 0.0; };
+    /**
+     * @brief    Returns the (inclusive) upper bound of the bucket that holds the given percentile (0 < p <= 1)
+     * 
+     */
+    Clk_t percentile(double p) const;
+
+    friend YAML::Emitter& operator << (YAML::Emitter& emitter, const LatencyHistogram& h);
+
+  private:
+    static size_t bucket_of(Clk_t latency);
+    static Clk_t bucket_lower_bound(size_t bucket);
+    static Clk_t bucket_upper_bound(size_t bucket);
+};
+
 class Implementation;
 class StatWrapperBase {
   public:
@@ -94,4 +132,4 @@ class StatWrapper : public StatWrapperBase {
 }        // namespace Ramulator
 
 
-#endif   // RAMULATOR_BASE_STATS_H
\ No newline at end of file
+#endif   // RAMULATOR_BASE_STATS_H
\ No newline at end of file
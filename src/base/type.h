@@ -2,16 +2,97 @@
 #define     RAMULATOR_BASE_TYPE_H
 
 #include <vector>
+#include <array>
 #include <unordered_map>
 #include <string>
 #include <type_traits>
+#include <initializer_list>
+#include <algorithm>
+#include <stdexcept>
 
 
 namespace Ramulator {
 
-using Clk_t     = int64_t;            // Clock cycle
-using Addr_t    = int64_t;            // Plain address as seen by the OS
-using AddrVec_t = std::vector<int>;   // Device address vector as is sent to the device from the controller
+/**
+ * @brief    A vector with a compile-time maximum size whose elements are stored inline (i.e., never on the heap)
+ * 
+ */
+template<typename T, size_t N>
+class InlineVector {
+  private:
+    std::array<T, N> m_data {};
+    size_t m_size = 0;
+
+  public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    InlineVector() = default;
+    InlineVector(size_t size, const T& val) { resize(size, val); };
+    InlineVector(std::initializer_list<T> vals) {
+      check_size(vals.size());
+      std::copy(vals.begin(), vals.end(), m_data.begin());
+      m_size = vals.size();
+    };
+
+    size_t size() const { return m_size; };
+    bool empty() const { return m_size == 0; };
+    static constexpr size_t max_size() { return N; };
+
+    void resize(size_t size, const T& val = T()) {
+      check_size(size);
+      if (size > m_size) {
+        std::fill(m_data.begin() + m_size, m_data.begin() + size, val);
+      }
+      m_size = size;
+    };
+
+    void push_back(const T& val) {
+      check_size(m_size + 1);
+      m_data[m_size++] = val;
+    };
+
+    void clear() { m_size = 0; };
+
+    T& operator[](size_t idx) { return m_data[idx]; };
+    const T& operator[](size_t idx) const { return m_data[idx]; };
+    T& back() { return m_data[m_size - 1]; };
+    const T& back() const { return m_data[m_size - 1]; };
+
+    iterator begin() { return m_data.data(); };
+    iterator end() { return m_data.data() + m_size; };
+    const_iterator begin() const { return m_data.data(); };
+    const_iterator end() const { return m_data.data() + m_size; };
+
+    /**
+     * @brief    Checks whether the first len elements of the two vectors are the same
+     * 
+     */
+    bool same_prefix(const InlineVector& other, size_t len) const {
+      for (size_t i = 0; i < len; i++) {
+        if (m_data[i] != other.m_data[i]) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    bool operator==(const InlineVector& other) const {
+      return m_size == other.m_size && same_prefix(other, m_size);
+    };
+
+  private:
+    void check_size(size_t size) const {
+      if (size > N) {
+        throw std::length_error("InlineVector cannot grow beyond its maximum size!");
+      }
+    };
+};
+
+using Clk_t     = int64_t;                // Clock cycle
+using Addr_t    = int64_t;                // Plain address as seen by the OS
+using AddrVec_t = InlineVector<int, 7>;   // Device address vector as is sent to the device from the controller (no standard has more than 7 levels)
 
 template<typename T>
 using Registry_t = std::unordered_map<std::string, T>;
@@ -55,6 +55,8 @@ class IDRAM : public Clocked<IDRAM> {
     TimingCons m_timing_cons;           // The actual timing constraints used by Ramulator's DRAM model
 
     Clk_t m_read_latency = -1;          // Number of cycles needed between issuing RD command and receiving data.
+    Clk_t m_write_latency = -1;         // Number of cycles needed between issuing WR command and the data being written.
+    Clk_t m_burst_cycles = -1;          // Number of cycles the data bus is occupied by the burst of a RD/WR command.
 
 
   /************************************************
@@ -88,6 +90,26 @@ class IDRAM : public Clocked<IDRAM> {
      */
     virtual bool check_ready(int command, const AddrVec_t& addr_vec) = 0;
 
+    /**
+     * @brief     Returns the earliest cycle at which the given command can be issued.
+     * @details
+     * Given a command and its address, this function should return the earliest cycle (no earlier than the
+     * current one) at which check_ready() would pass, assuming no other command is issued in between.
+     * Standards whose prerequisite commands change over time may return an earlier cycle, so the result
+     * should be treated as a lower bound at which the command needs to be re-evaluated.
+     * 
+     */
+    virtual Clk_t get_earliest_issue_clk(int command, const AddrVec_t& addr_vec) = 0;
+
+    /**
+     * @brief     Returns a version number of the states along the path to the given address
+     * @details
+     * The returned version only changes when the states of a node on the path (or the states of its
+     * descendants) might have changed, e.g., to let the controller cache the prerequisite commands.
+     * 
+     */
+    virtual uint64_t get_state_version(const AddrVec_t& addr_vec) = 0;
+
     /**
      * @brief     Checks whether the command will result in a rowbuffer hit
      * @details
@@ -97,6 +119,16 @@ class IDRAM : public Clocked<IDRAM> {
      */
     virtual bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) = 0;
 
+    /**
+     * @brief     Checks whether the node accessed by the command has an open row
+     * @details
+     * Given a command and its address, this function should return whether the node (e.g., the bank)
+     * it accesses has an opened row, regardless of which row it is. Together with check_rowbuffer_hit(),
+     * this tells apart row hits, row misses (closed) and row conflicts (another row is open).
+     * 
+     */
+    virtual bool check_node_open(int command, const AddrVec_t& addr_vec) = 0;
+
     /**
      * @brief     An universal interface for the host to change DRAM configurations on the fly
      * @details
@@ -107,6 +139,46 @@ class IDRAM : public Clocked<IDRAM> {
      */
     virtual void notify(std::string_view key, uint64_t value) {};
 
+    /**
+     * @brief     Advances the device clock by num_cycles cycles in which no command is issued
+     *
+     */
+    virtual void fast_forward(Clk_t num_cycles) { m_clk += num_cycles; };
+
+
+  /************************************************
+   *                Channel Clocks
+   ***********************************************/
+  protected:
+    std::vector<Clk_t> m_channel_leads;   // Number of cycles each channel is ahead of the device clock (empty if the channels are not ticked on their own)
+
+  public:
+    /**
+     * @brief     Lets the channels be ticked on their own (e.g., each by the thread that ticks its controller)
+     * @details
+     * The channels share no timing or state information, so they can run ahead of the device clock independently.
+     * All commands and queries to a channel then use the clock of that channel.
+     *
+     */
+    void enable_channel_clocks(int num_channels) { m_channel_leads.assign(num_channels, 0); };
+
+    void tick_channel(int channel_id) { m_channel_leads[channel_id]++; };
+
+    /**
+     * @brief     Advances the device clock to the channels, which must all have been ticked the same number of times
+     *
+     */
+    void sync_channel_clocks() {
+      if (m_channel_leads.size()) {
+        m_clk += m_channel_leads[0];
+        std::fill(m_channel_leads.begin(), m_channel_leads.end(), 0);
+      }
+    };
+
+    Clk_t get_channel_clk(int channel_id) const {
+      return m_channel_leads.size() ? m_clk + m_channel_leads[channel_id] : m_clk;
+    };
+
 
   /************************************************
    *        Interface to Query Device Spec
@@ -120,6 +192,32 @@ class IDRAM : public Clocked<IDRAM> {
         return -1;
       }
     }
+
+    /**
+     * @brief    Returns the number of nodes at the given level in a channel
+     * 
+     */
+    int get_num_flat_ids(int level) const {
+      int num_ids = 1;
+      for (int l = 1; l <= level; l++) {
+        num_ids *= m_organization.count[l];
+      }
+      return num_ids;
+    }
+
+    /**
+     * @brief    Returns the id of the node at the given level that the address points to, numbered across its channel
+     * @details
+     * E.g., the flat bank id of a DDR4 address is (rank * num_bankgroups + bankgroup) * num_banks + bank.
+     * 
+     */
+    int get_flat_id(const AddrVec_t& addr_vec, int level) const {
+      int flat_id = 0;
+      for (int l = 1; l <= level; l++) {
+        flat_id = flat_id * m_organization.count[l] + addr_vec[l];
+      }
+      return flat_id;
+    }
 };
 
 #define RAMULATOR_DECLARE_SPECS() \
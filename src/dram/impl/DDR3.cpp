@@ -134,10 +134,8 @@ class DDR3 : public IDRAM, public Implementation {
     };
     std::vector<Node*> m_channels;
     
-    FuncMatrix<ActionFunc_t<Node>>  m_actions;
-    FuncMatrix<PreqFunc_t<Node>>    m_preqs;
-    FuncMatrix<RowhitFunc_t<Node>>  m_rowhits;
-    FuncMatrix<RowopenFunc_t<Node>> m_rowopens;
+    template<typename F>
+    using FuncTable_t = FuncTable<F, m_levels.size(), m_commands.size()>;
 
 
   public:
@@ -149,34 +147,44 @@ class DDR3 : public IDRAM, public Implementation {
       RAMULATOR_DECLARE_SPECS();
       set_organization();
       set_timing_vals();
-
-      set_actions();
-      set_preqs();
-      set_rowhits();
-      set_rowopens();
       
       create_nodes();
     };
 
     void issue_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      m_channels[channel_id]->update_timing(command, addr_vec, m_clk);
-      m_channels[channel_id]->update_states(command, addr_vec, m_clk);
+      m_channels[channel_id]->update_timing(command, addr_vec, get_channel_clk(channel_id));
+      m_channels[channel_id]->update_states(command, addr_vec, get_channel_clk(channel_id));
     };
 
     int get_preq_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      return m_channels[channel_id]->get_preq_command(command, addr_vec, m_clk);
+      return m_channels[channel_id]->get_preq_command(command, addr_vec, get_channel_clk(channel_id));
     };
 
     bool check_ready(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
+      return m_channels[channel_id]->check_ready(command, addr_vec, get_channel_clk(channel_id));
+    };
+
+    Clk_t get_earliest_issue_clk(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return std::max(get_channel_clk(channel_id), m_channels[channel_id]->get_ready_clk(command, addr_vec));
+    };
+
+    uint64_t get_state_version(const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_state_version(addr_vec);
     };
 
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
+      return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, get_channel_clk(channel_id));
+    };
+
+    bool check_node_open(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->check_node_open(command, addr_vec, get_channel_clk(channel_id));
     };
 
   private:
@@ -336,8 +344,10 @@ class DDR3 : public IDRAM, public Implementation {
         }
       }      
 
-      // Set read latency
+      // Set read and write latency and the burst duration
       m_read_latency = m_timing_vals("nCL") + m_timing_vals("nBL");
+      m_write_latency = m_timing_vals("nCWL") + m_timing_vals("nBL");
+      m_burst_cycles = m_timing_vals("nBL");
 
       // Populate the timing constraints
       #define V(timing) (m_timing_vals(timing))
@@ -389,46 +399,56 @@ class DDR3 : public IDRAM, public Implementation {
 
     };
 
-    void set_actions() {
-      m_actions.resize(m_levels.size(), std::vector<ActionFunc_t<Node>>(m_commands.size()));
+  public:
+    static constexpr auto get_actions() {
+      FuncTable_t<ActionFunc_t<Node>> actions;
 
       // Rank Actions
-      m_actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<DDR3>;
+      actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<DDR3>;
 
       // Bank actions
-      m_actions[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Action::Bank::ACT<DDR3>;
-      m_actions[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Action::Bank::PRE<DDR3>;
-      m_actions[m_levels["bank"]][m_commands["RDA"]] = Lambdas::Action::Bank::PRE<DDR3>;
-      m_actions[m_levels["bank"]][m_commands["WRA"]] = Lambdas::Action::Bank::PRE<DDR3>;
+      actions[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Action::Bank::ACT<DDR3>;
+      actions[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Action::Bank::PRE<DDR3>;
+      actions[m_levels["bank"]][m_commands["RDA"]] = Lambdas::Action::Bank::PRE<DDR3>;
+      actions[m_levels["bank"]][m_commands["WRA"]] = Lambdas::Action::Bank::PRE<DDR3>;
+
+      return actions;
     };
 
-    void set_preqs() {
-      m_preqs.resize(m_levels.size(), std::vector<PreqFunc_t<Node>>(m_commands.size()));
+    static constexpr auto get_preqs() {
+      FuncTable_t<PreqFunc_t<Node>> preqs;
 
       // Rank Actions
-      m_preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR3>;
+      preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR3>;
 
       // Bank actions
-      m_preqs[m_levels["bank"]][m_commands["RD"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR3>;
-      m_preqs[m_levels["bank"]][m_commands["WR"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR3>;
+      preqs[m_levels["bank"]][m_commands["RD"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR3>;
+      preqs[m_levels["bank"]][m_commands["WR"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR3>;
+
+      return preqs;
     };
 
-    void set_rowhits() {
-      m_rowhits.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+    static constexpr auto get_rowhits() {
+      FuncTable_t<RowhitFunc_t<Node>> rowhits;
+
+      rowhits[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowHit::Bank::RDWR<DDR3>;
+      rowhits[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowHit::Bank::RDWR<DDR3>;
 
-      m_rowhits[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowHit::Bank::RDWR<DDR3>;
-      m_rowhits[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowHit::Bank::RDWR<DDR3>;
+      return rowhits;
     }
 
 
-    void set_rowopens() {
-      m_rowopens.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+    static constexpr auto get_rowopens() {
+      FuncTable_t<RowopenFunc_t<Node>> rowopens;
 
-      m_rowopens[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowOpen::Bank::RDWR<DDR3>;
-      m_rowopens[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowOpen::Bank::RDWR<DDR3>;
+      rowopens[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowOpen::Bank::RDWR<DDR3>;
+      rowopens[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowOpen::Bank::RDWR<DDR3>;
+
+      return rowopens;
     }
 
 
+  private:
     void create_nodes() {
       int num_channels = m_organization.count[m_levels["channel"]];
       for (int i = 0; i < num_channels; i++) {
@@ -156,10 +156,10 @@ class DDR4VRR : public IDRAM, public Implementation {
     };
     std::vector<Node*> m_channels;
     
-    FuncMatrix<ActionFunc_t<Node>>  m_actions;
-    FuncMatrix<PreqFunc_t<Node>>    m_preqs;
-    FuncMatrix<RowhitFunc_t<Node>>  m_rowhits;
-    FuncMatrix<RowopenFunc_t<Node>> m_rowopens;
+    template<typename F>
+    using FuncTable_t = FuncTable<F, m_levels.size(), m_commands.size()>;
+
+    int m_fgr_mode = 1;   // Fine granularity refresh mode (1x, 2x, or 4x)
 
 
   public:
@@ -171,34 +171,63 @@ class DDR4VRR : public IDRAM, public Implementation {
       RAMULATOR_DECLARE_SPECS();
       set_organization();
       set_timing_vals();
-
-      set_actions();
-      set_preqs();
-      set_rowhits();
-      set_rowopens();
       
       create_nodes();
     };
 
     void issue_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      m_channels[channel_id]->update_timing(command, addr_vec, m_clk);
-      m_channels[channel_id]->update_states(command, addr_vec, m_clk);
+      m_channels[channel_id]->update_timing(command, addr_vec, get_channel_clk(channel_id));
+      m_channels[channel_id]->update_states(command, addr_vec, get_channel_clk(channel_id));
     };
 
     int get_preq_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      return m_channels[channel_id]->get_preq_command(command, addr_vec, m_clk);
+      return m_channels[channel_id]->get_preq_command(command, addr_vec, get_channel_clk(channel_id));
     };
 
     bool check_ready(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
+      return m_channels[channel_id]->check_ready(command, addr_vec, get_channel_clk(channel_id));
+    };
+
+    Clk_t get_earliest_issue_clk(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return std::max(get_channel_clk(channel_id), m_channels[channel_id]->get_ready_clk(command, addr_vec));
+    };
+
+    uint64_t get_state_version(const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_state_version(addr_vec);
     };
 
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
+      return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, get_channel_clk(channel_id));
+    };
+
+    bool check_node_open(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->check_node_open(command, addr_vec, get_channel_clk(channel_id));
+    };
+
+    /**
+     * @brief    Switches the fine granularity refresh mode on the fly (key "fgr_mode", value 1, 2, or 4)
+     * @details
+     * The refresh timings are taken from the JEDEC tables, i.e., a user-provided nRFC or nREFI does not carry over.
+     * 
+     */
+    void notify(std::string_view key, uint64_t value) override {
+      if (key != "fgr_mode") {
+        return;
+      }
+      m_fgr_mode = value;
+      set_refresh_timing_vals();
+      m_timing_cons.clear();
+      set_timing_cons();
+      for (auto channel : m_channels) {
+        channel->m_store->update_timing_cons();
+      }
     };
 
   private:
@@ -327,28 +356,8 @@ class DDR4VRR : public IDRAM, public Implementation {
       }
 
       // Refresh timings
-      // tRFC table (unit is nanosecond!)
-      constexpr int tRFC_TABLE[3][4] = {
-      //  2Gb   4Gb   8Gb  16Gb
-        { 160,  260,  360,  550}, // Normal refresh (tRFC1)
-        { 110,  160,  260,  350}, // FGR 2x (tRFC2)
-        { 90,   110,  160,  260}, // FGR 4x (tRFC4)
-      };
-
-      // tREFI(base) table (unit is nanosecond!)
-      constexpr int tREFI_BASE = 7800;
-      int density_id = [](int density_Mb) -> int { 
-        switch (density_Mb) {
-          case 2048:  return 0;
-          case 4096:  return 1;
-          case 8192:  return 2;
-          case 16384: return 3;
-          default:    return -1;
-        }
-      }(m_organization.density);
-
-      m_timing_vals("nRFC")  = JEDEC_rounding(tRFC_TABLE[0][density_id], tCK_ps);
-      m_timing_vals("nREFI") = JEDEC_rounding(tREFI_BASE, tCK_ps);
+      m_fgr_mode = param<int>("fgr_mode").desc("Fine granularity refresh (FGR) mode: 1 (normal), 2 (2x), or 4 (4x).").default_val(1);
+      set_refresh_timing_vals();
 
       m_VRR_radius = param<int>("VRR_radius").desc("The number of rows to refresh on each side").default_val(4);
       const int nVRR_base_ns = 110;   // Taken from DDR5 DRFM
@@ -375,9 +384,15 @@ class DDR4VRR : public IDRAM, public Implementation {
         }
       }      
 
-      // Set read latency
+      // Set read and write latency and the burst duration
       m_read_latency = m_timing_vals("nCL") + m_timing_vals("nBL") + m_timing_vals("nAL");
+      m_write_latency = m_timing_vals("nCWL") + m_timing_vals("nBL") + m_timing_vals("nAL");
+      m_burst_cycles = m_timing_vals("nBL");
 
+      set_timing_cons();
+    };
+
+    void set_timing_cons() {
       // Populate the timing constraints
       #define V(timing) (m_timing_vals(timing))
       populate_timingcons(this, {
@@ -439,48 +454,100 @@ class DDR4VRR : public IDRAM, public Implementation {
 
     };
 
-    void set_actions() {
-      m_actions.resize(m_levels.size(), std::vector<ActionFunc_t<Node>>(m_commands.size()));
+    /**
+     * @brief    Sets the refresh timings of the fine granularity refresh mode (tRFC1/2/4 with tREFI/1/2/4)
+     * 
+     */
+    void set_refresh_timing_vals() {
+      int fgr_id = [](int fgr_mode) -> int {
+        switch (fgr_mode) {
+          case 1:  return 0;
+          case 2:  return 1;
+          case 4:  return 2;
+          default: return -1;
+        }
+      }(m_fgr_mode);
+      if (fgr_id == -1) {
+        throw ConfigurationError("Unrecognized fine granularity refresh mode {}x in {}!", m_fgr_mode, get_name());
+      }
+      int tCK_ps = m_timing_vals("tCK_ps");
+
+      // tRFC table (unit is nanosecond!)
+      constexpr int tRFC_TABLE[3][4] = {
+      //  2Gb   4Gb   8Gb  16Gb
+        { 160,  260,  360,  550}, // Normal refresh (tRFC1)
+        { 110,  160,  260,  350}, // FGR 2x (tRFC2)
+        { 90,   110,  160,  260}, // FGR 4x (tRFC4)
+      };
+
+      // tREFI(base) table (unit is nanosecond!)
+      constexpr int tREFI_BASE = 7800;
+      int density_id = [](int density_Mb) -> int { 
+        switch (density_Mb) {
+          case 2048:  return 0;
+          case 4096:  return 1;
+          case 8192:  return 2;
+          case 16384: return 3;
+          default:    return -1;
+        }
+      }(m_organization.density);
+
+      m_timing_vals("nRFC")  = JEDEC_rounding(tRFC_TABLE[fgr_id][density_id], tCK_ps);
+      m_timing_vals("nREFI") = JEDEC_rounding(tREFI_BASE / m_fgr_mode, tCK_ps);
+    };
+
+  public:
+    static constexpr auto get_actions() {
+      FuncTable_t<ActionFunc_t<Node>> actions;
 
       // Rank Actions
-      m_actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<DDR4VRR>;
+      actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<DDR4VRR>;
 
       // Bank actions
-      m_actions[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Action::Bank::ACT<DDR4VRR>;
-      m_actions[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Action::Bank::PRE<DDR4VRR>;
-      m_actions[m_levels["bank"]][m_commands["RDA"]] = Lambdas::Action::Bank::PRE<DDR4VRR>;
-      m_actions[m_levels["bank"]][m_commands["WRA"]] = Lambdas::Action::Bank::PRE<DDR4VRR>;
+      actions[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Action::Bank::ACT<DDR4VRR>;
+      actions[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Action::Bank::PRE<DDR4VRR>;
+      actions[m_levels["bank"]][m_commands["RDA"]] = Lambdas::Action::Bank::PRE<DDR4VRR>;
+      actions[m_levels["bank"]][m_commands["WRA"]] = Lambdas::Action::Bank::PRE<DDR4VRR>;
+
+      return actions;
     };
 
-    void set_preqs() {
-      m_preqs.resize(m_levels.size(), std::vector<PreqFunc_t<Node>>(m_commands.size()));
+    static constexpr auto get_preqs() {
+      FuncTable_t<PreqFunc_t<Node>> preqs;
 
       // Rank Actions
-      m_preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR4VRR>;
+      preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR4VRR>;
 
       // Bank actions
-      m_preqs[m_levels["bank"]][m_commands["RD"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR4VRR>;
-      m_preqs[m_levels["bank"]][m_commands["WR"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR4VRR>;
+      preqs[m_levels["bank"]][m_commands["RD"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR4VRR>;
+      preqs[m_levels["bank"]][m_commands["WR"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR4VRR>;
 
-      m_preqs[m_levels["bank"]][m_commands["VRR"]] = Lambdas::Preq::Bank::RequireBankClosed<DDR4VRR>;
+      preqs[m_levels["bank"]][m_commands["VRR"]] = Lambdas::Preq::Bank::RequireBankClosed<DDR4VRR>;
+
+      return preqs;
     };
 
-    void set_rowhits() {
-      m_rowhits.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+    static constexpr auto get_rowhits() {
+      FuncTable_t<RowhitFunc_t<Node>> rowhits;
+
+      rowhits[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowHit::Bank::RDWR<DDR4VRR>;
+      rowhits[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowHit::Bank::RDWR<DDR4VRR>;
 
-      m_rowhits[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowHit::Bank::RDWR<DDR4VRR>;
-      m_rowhits[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowHit::Bank::RDWR<DDR4VRR>;
+      return rowhits;
     }
 
 
-    void set_rowopens() {
-      m_rowopens.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+    static constexpr auto get_rowopens() {
+      FuncTable_t<RowopenFunc_t<Node>> rowopens;
 
-      m_rowopens[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowOpen::Bank::RDWR<DDR4VRR>;
-      m_rowopens[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowOpen::Bank::RDWR<DDR4VRR>;
+      rowopens[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowOpen::Bank::RDWR<DDR4VRR>;
+      rowopens[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowOpen::Bank::RDWR<DDR4VRR>;
+
+      return rowopens;
     }
 
 
+  private:
     void create_nodes() {
       int num_channels = m_organization.count[m_levels["channel"]];
       for (int i = 0; i < num_channels; i++) {
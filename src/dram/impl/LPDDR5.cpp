@@ -77,13 +77,15 @@ class LPDDR5 : public IDRAM, public Implementation {
 
     inline static constexpr ImplDef m_requests = {
       "read16", "write16",
-      "all-bank-refresh", "per-bank-refresh"
+      "all-bank-refresh", "per-bank-refresh",
+      "precharge",
     };
 
     inline static const ImplLUT m_request_translations = LUT (
       m_requests, m_commands, {
         {"read16", "RD16"}, {"write16", "WR16"}, 
         {"all-bank-refresh", "REFab"}, {"per-bank-refresh", "REFpb"},
+        {"precharge", "PRE"},
       }
     );
 
@@ -125,6 +127,9 @@ class LPDDR5 : public IDRAM, public Implementation {
       }
     );
 
+    // ACT-2 can open a different row than the one pre-opened by ACT-1
+    inline static constexpr int m_max_open_rows = 2;
+
   public:
     struct Node : public DRAMNodeBase<LPDDR5> {
       Clk_t m_final_synced_cycle = -1; // Extra CAS Sync command needed for RD/WR after this cycle
@@ -133,10 +138,8 @@ class LPDDR5 : public IDRAM, public Implementation {
     };
     std::vector<Node*> m_channels;
     
-    FuncMatrix<ActionFunc_t<Node>>  m_actions;
-    FuncMatrix<PreqFunc_t<Node>>    m_preqs;
-    FuncMatrix<RowhitFunc_t<Node>>  m_rowhits;
-    FuncMatrix<RowopenFunc_t<Node>> m_rowopens;
+    template<typename F>
+    using FuncTable_t = FuncTable<F, m_levels.size(), m_commands.size()>;
 
 
   public:
@@ -148,34 +151,54 @@ class LPDDR5 : public IDRAM, public Implementation {
       RAMULATOR_DECLARE_SPECS();
       set_organization();
       set_timing_vals();
-
-      set_actions();
-      set_preqs();
-      set_rowhits();
-      set_rowopens();
       
       create_nodes();
     };
 
     void issue_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      m_channels[channel_id]->update_timing(command, addr_vec, m_clk);
-      m_channels[channel_id]->update_states(command, addr_vec, m_clk);
+      m_channels[channel_id]->update_timing(command, addr_vec, get_channel_clk(channel_id));
+      m_channels[channel_id]->update_states(command, addr_vec, get_channel_clk(channel_id));
     };
 
     int get_preq_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      return m_channels[channel_id]->get_preq_command(command, addr_vec, m_clk);
+      return m_channels[channel_id]->get_preq_command(command, addr_vec, get_channel_clk(channel_id));
     };
 
     bool check_ready(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
+      return m_channels[channel_id]->check_ready(command, addr_vec, get_channel_clk(channel_id));
+    };
+
+    Clk_t get_earliest_issue_clk(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      Clk_t issue_clk = std::max(get_channel_clk(channel_id), m_channels[channel_id]->get_ready_clk(command, addr_vec));
+
+      // RD16/WR16 turn into CASRD/CASWR once the WCK sync of the rank expires, so the caller has to re-evaluate then
+      int rank_id = addr_vec[m_levels["rank"]];
+      if (rank_id >= 0) {
+        Clk_t sync_end_clk = m_channels[channel_id]->m_child_nodes[rank_id]->m_final_synced_cycle + 1;
+        if (sync_end_clk > get_channel_clk(channel_id)) {
+          issue_clk = std::min(issue_clk, sync_end_clk);
+        }
+      }
+      return issue_clk;
+    };
+
+    uint64_t get_state_version(const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_state_version(addr_vec);
     };
 
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
+      return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, get_channel_clk(channel_id));
+    };
+
+    bool check_node_open(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->check_node_open(command, addr_vec, get_channel_clk(channel_id));
     };
 
   private:
@@ -330,8 +353,10 @@ class LPDDR5 : public IDRAM, public Implementation {
         }
       }      
 
-      // Set read latency
+      // Set read and write latency and the burst duration
       m_read_latency = m_timing_vals("nCL") + m_timing_vals("nBL16");
+      m_write_latency = m_timing_vals("nCWL") + m_timing_vals("nBL16");
+      m_burst_cycles = m_timing_vals("nBL16");
 
       // Populate the timing constraints
       #define V(timing) (m_timing_vals(timing))
@@ -394,126 +419,169 @@ class LPDDR5 : public IDRAM, public Implementation {
 
     };
 
-    void set_actions() {
-      m_actions.resize(m_levels.size(), std::vector<ActionFunc_t<Node>>(m_commands.size()));
+    // LPDDR5-specific behaviors (named functions rather than lambdas so that the constexpr tables can refer to them)
+    static void action_CASRD(Node* node, int cmd, int target_id, Clk_t clk) {
+      node->m_final_synced_cycle = clk + m_timings["nCL"] + m_timings["nBL16"] + 1; 
+    };
 
-      // Rank Actions
-      m_actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<LPDDR5>;
-      m_actions[m_levels["rank"]][m_commands["CASRD"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        node->m_final_synced_cycle = clk + m_timings["nCL"] + m_timings["nBL16"] + 1; 
-      };
-      m_actions[m_levels["rank"]][m_commands["CASWR"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        node->m_final_synced_cycle = clk + m_timings["nCWL"] + m_timings["nBL16"] + 1; 
-      };
-      m_actions[m_levels["rank"]][m_commands["RD16"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        node->m_final_synced_cycle = clk + m_timings["nCL"] + m_timings["nBL16"]; 
-      };
-      m_actions[m_levels["rank"]][m_commands["WR16"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        node->m_final_synced_cycle = clk + m_timings["nCWL"] + m_timings["nBL16"]; 
-      };
-      // Bank actions
-      m_actions[m_levels["bank"]][m_commands["ACT-1"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        node->m_state = m_states["Pre-Opened"];
-        node->m_row_state[target_id] = m_states["Pre-Opened"];
-      };
-      m_actions[m_levels["bank"]][m_commands["ACT-2"]] = Lambdas::Action::Bank::ACT<LPDDR5>;
-      m_actions[m_levels["bank"]][m_commands["PRE"]]   = Lambdas::Action::Bank::PRE<LPDDR5>;
-      m_actions[m_levels["bank"]][m_commands["RD16A"]] = Lambdas::Action::Bank::PRE<LPDDR5>;
-      m_actions[m_levels["bank"]][m_commands["WR16A"]] = Lambdas::Action::Bank::PRE<LPDDR5>;
+    static void action_CASWR(Node* node, int cmd, int target_id, Clk_t clk) {
+      node->m_final_synced_cycle = clk + m_timings["nCWL"] + m_timings["nBL16"] + 1; 
     };
 
-    void set_preqs() {
-      m_preqs.resize(m_levels.size(), std::vector<PreqFunc_t<Node>>(m_commands.size()));
+    static void action_RD16(Node* node, int cmd, int target_id, Clk_t clk) {
+      node->m_final_synced_cycle = clk + m_timings["nCL"] + m_timings["nBL16"]; 
+    };
 
-      // Rank Preqs
-      m_preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<LPDDR5>;
-      m_preqs[m_levels["rank"]][m_commands["RFMab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<LPDDR5>;
-
-      m_preqs[m_levels["rank"]][m_commands["REFpb"]] = [this] (Node* node, int cmd, int target_id, Clk_t clk) {
-        int target_bank_id = target_id;
-        int another_target_bank_id = target_id + 8;
-
-        for (auto bg : node->m_child_nodes) {
-          for (auto bank : bg->m_child_nodes) {
-            int num_banks_per_bg = m_organization.count[m_levels["bank"]];
-            int flat_bankid = bank->m_node_id + bg->m_node_id * num_banks_per_bg;
-            if (flat_bankid == target_id || flat_bankid == another_target_bank_id) {
-              switch (node->m_state) {
-                case m_states["Pre-Opened"]: return m_commands["PRE"];
-                case m_states["Opened"]: return m_commands["PRE"];
-              }
-            }
-          }
-        }
+    static void action_WR16(Node* node, int cmd, int target_id, Clk_t clk) {
+      node->m_final_synced_cycle = clk + m_timings["nCWL"] + m_timings["nBL16"]; 
+    };
 
-        return cmd;
-      };
-      
-      m_preqs[m_levels["rank"]][m_commands["RFMpb"]] = m_preqs[m_levels["rank"]][m_commands["REFpb"]];
+    static void action_ACT1(Node* node, int cmd, int target_id, Clk_t clk) {
+      node->m_state = m_states["Pre-Opened"];
+      node->m_row_state.set_state(target_id, m_states["Pre-Opened"]);
+    };
 
-      // Bank Preqs
-      m_preqs[m_levels["bank"]][m_commands["RD16"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        switch (node->m_state) {
-          case m_states["Closed"]: return m_commands["ACT-1"];
-          case m_states["Pre-Opened"]: return m_commands["ACT-2"];
-          case m_states["Opened"]: {
-            if (node->m_row_state.find(target_id) != node->m_row_state.end()) {
-              Node* rank = node->m_parent_node->m_parent_node;
-              if (rank->m_final_synced_cycle < clk) {
-                return m_commands["CASRD"];
-              } else {
-                return cmd;
-              }
+    // The refresh is addressed to the first bank (t) of the refreshed pair (t and t + 8), which is precharged here.
+    // The refresh manager precharges the other bank before sending the refresh (see PerBankRefresh), so the rank
+    // is only closed if that bank was opened again in the meantime.
+    static int preq_REFpb(Node* node, int cmd, int target_id, Clk_t clk) {
+      switch (node->m_state) {
+        case m_states["Pre-Opened"]: return m_commands["PRE"];
+        case m_states["Opened"]: return m_commands["PRE"];
+      }
+
+      Node* rank = node->m_parent_node->m_parent_node;
+      int num_banks_per_bg = node->m_spec->m_organization.count[m_levels["bank"]];
+      int another_target_bank_id = node->m_node_id + node->m_parent_node->m_node_id * num_banks_per_bg + 8;
+      Node* another_bank = rank->m_child_nodes[another_target_bank_id / num_banks_per_bg]->m_child_nodes[another_target_bank_id % num_banks_per_bg];
+      switch (another_bank->m_state) {
+        case m_states["Pre-Opened"]: return m_commands["PREA"];
+        case m_states["Opened"]: return m_commands["PREA"];
+      }
+
+      return cmd;
+    };
+
+    static int preq_RD16(Node* node, int cmd, int target_id, Clk_t clk) {
+      switch (node->m_state) {
+        case m_states["Closed"]: return m_commands["ACT-1"];
+        case m_states["Pre-Opened"]: return m_commands["ACT-2"];
+        case m_states["Opened"]: {
+          if (node->m_row_state.contains(target_id)) {
+            Node* rank = node->m_parent_node->m_parent_node;
+            if (rank->m_final_synced_cycle < clk) {
+              return m_commands["CASRD"];
             } else {
-              return m_commands["PRE"];
+              return cmd;
             }
-          }    
-          default: {
-            spdlog::error("[Preq::Bank] Invalid bank state for an RD/WR command!");
-            std::exit(-1);      
-          } 
-        }
-      };
-      m_preqs[m_levels["bank"]][m_commands["WR16"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        switch (node->m_state) {
-          case m_states["Closed"]: return m_commands["ACT-1"];
-          case m_states["Pre-Opened"]: return m_commands["ACT-2"];
-          case m_states["Opened"]: {
-            if (node->m_row_state.find(target_id) != node->m_row_state.end()) {
-              Node* rank = node->m_parent_node->m_parent_node;
-              if (rank->m_final_synced_cycle < clk) {
-                return m_commands["CASWR"];
-              } else {
-                return cmd;
-              }
+          } else {
+            return m_commands["PRE"];
+          }
+        }    
+        default: {
+          spdlog::error("[Preq::Bank] Invalid bank state for an RD/WR command!");
+          std::exit(-1);      
+        } 
+      }
+    };
+
+    static int preq_WR16(Node* node, int cmd, int target_id, Clk_t clk) {
+      switch (node->m_state) {
+        case m_states["Closed"]: return m_commands["ACT-1"];
+        case m_states["Pre-Opened"]: return m_commands["ACT-2"];
+        case m_states["Opened"]: {
+          if (node->m_row_state.contains(target_id)) {
+            Node* rank = node->m_parent_node->m_parent_node;
+            if (rank->m_final_synced_cycle < clk) {
+              return m_commands["CASWR"];
             } else {
-              return m_commands["PRE"];
+              return cmd;
             }
-          }    
-          default: {
-            spdlog::error("[Preq::Bank] Invalid bank state for an RD/WR command!");
-            std::exit(-1);      
-          } 
-        }
-      };
+          } else {
+            return m_commands["PRE"];
+          }
+        }    
+        default: {
+          spdlog::error("[Preq::Bank] Invalid bank state for an RD/WR command!");
+          std::exit(-1);      
+        } 
+      }
+    };
+
+    // A bank that is being activated (i.e., after ACT-1) already has its row open
+    static bool rowhit_RDWR(Node* node, int cmd, int target_id, Clk_t clk) {
+      if (node->m_state == m_states["Pre-Opened"]) {
+        return node->m_row_state.contains(target_id);
+      }
+      return Lambdas::RowHit::Bank::RDWR<LPDDR5>(node, cmd, target_id, clk);
+    };
+
+    static bool rowopen_RDWR(Node* node, int cmd, int target_id, Clk_t clk) {
+      if (node->m_state == m_states["Pre-Opened"]) {
+        return true;
+      }
+      return Lambdas::RowOpen::Bank::RDWR<LPDDR5>(node, cmd, target_id, clk);
+    };
+
+  public:
+    static constexpr auto get_actions() {
+      FuncTable_t<ActionFunc_t<Node>> actions;
+
+      // Rank Actions
+      actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<LPDDR5>;
+      actions[m_levels["rank"]][m_commands["CASRD"]] = action_CASRD;
+      actions[m_levels["rank"]][m_commands["CASWR"]] = action_CASWR;
+      actions[m_levels["rank"]][m_commands["RD16"]] = action_RD16;
+      actions[m_levels["rank"]][m_commands["WR16"]] = action_WR16;
+      // Bank actions
+      actions[m_levels["bank"]][m_commands["ACT-1"]] = action_ACT1;
+      actions[m_levels["bank"]][m_commands["ACT-2"]] = Lambdas::Action::Bank::ACT<LPDDR5>;
+      actions[m_levels["bank"]][m_commands["PRE"]]   = Lambdas::Action::Bank::PRE<LPDDR5>;
+      actions[m_levels["bank"]][m_commands["RD16A"]] = Lambdas::Action::Bank::PRE<LPDDR5>;
+      actions[m_levels["bank"]][m_commands["WR16A"]] = Lambdas::Action::Bank::PRE<LPDDR5>;
+
+      return actions;
+    };
+
+    static constexpr auto get_preqs() {
+      FuncTable_t<PreqFunc_t<Node>> preqs;
+
+      // Rank Preqs
+      preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<LPDDR5>;
+      preqs[m_levels["rank"]][m_commands["RFMab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<LPDDR5>;
+
+      // Bank Preqs
+      preqs[m_levels["bank"]][m_commands["RD16"]] = preq_RD16;
+      preqs[m_levels["bank"]][m_commands["WR16"]] = preq_WR16;
+
+      preqs[m_levels["bank"]][m_commands["REFpb"]] = preq_REFpb;
+      
+      preqs[m_levels["bank"]][m_commands["RFMpb"]] = preqs[m_levels["bank"]][m_commands["REFpb"]];
+
+      return preqs;
     };
 
-    void set_rowhits() {
-      m_rowhits.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+    static constexpr auto get_rowhits() {
+      FuncTable_t<RowhitFunc_t<Node>> rowhits;
+
+      rowhits[m_levels["bank"]][m_commands["RD16"]] = rowhit_RDWR;
+      rowhits[m_levels["bank"]][m_commands["WR16"]] = rowhit_RDWR;
 
-      m_rowhits[m_levels["bank"]][m_commands["RD16"]] = Lambdas::RowHit::Bank::RDWR<LPDDR5>;
-      m_rowhits[m_levels["bank"]][m_commands["WR16"]] = Lambdas::RowHit::Bank::RDWR<LPDDR5>;
+      return rowhits;
     }
 
 
-    void set_rowopens() {
-      m_rowopens.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+    static constexpr auto get_rowopens() {
+      FuncTable_t<RowopenFunc_t<Node>> rowopens;
 
-      m_rowopens[m_levels["bank"]][m_commands["RD16"]] = Lambdas::RowOpen::Bank::RDWR<LPDDR5>;
-      m_rowopens[m_levels["bank"]][m_commands["WR16"]] = Lambdas::RowOpen::Bank::RDWR<LPDDR5>;
+      rowopens[m_levels["bank"]][m_commands["RD16"]] = rowopen_RDWR;
+      rowopens[m_levels["bank"]][m_commands["WR16"]] = rowopen_RDWR;
+
+      return rowopens;
     }
 
 
+  private:
     void create_nodes() {
       int num_channels = m_organization.count[m_levels["channel"]];
       for (int i = 0; i < num_channels; i++) {
@@ -0,0 +1,63 @@
+#ifndef     RAMULATOR_DRAM_DDR4_REFRESH_H
+#define     RAMULATOR_DRAM_DDR4_REFRESH_H
+
+#include "base/base.h"
+#include "base/utils.h"
+
+namespace Ramulator {
+
+struct DDR4RefreshTimings {
+  int nRFC = -1;
+  int nREFI = -1;
+};
+
+/**
+ * @brief    Returns the JEDEC refresh timings (tRFC1/2/4 and tREFI/1/2/4) of a DDR4 fine granularity refresh mode
+ * @details
+ * Both timings are -1 if the mode is not 1, 2, or 4, and nRFC is -1 if the density is not in the tRFC table.
+ * 
+ */
+inline DDR4RefreshTimings get_DDR4_refresh_timings(int fgr_mode, int density_Mb, int tCK_ps) {
+  int fgr_id = [](int fgr_mode) -> int {
+    switch (fgr_mode) {
+      case 1:  return 0;
+      case 2:  return 1;
+      case 4:  return 2;
+      default: return -1;
+    }
+  }(fgr_mode);
+  if (fgr_id == -1) {
+    return {};
+  }
+
+  // tRFC table (unit is nanosecond!)
+  constexpr int tRFC_TABLE[3][4] = {
+  //  2Gb   4Gb   8Gb  16Gb
+    { 160,  260,  360,  550}, // Normal refresh (tRFC1)
+    { 110,  160,  260,  350}, // FGR 2x (tRFC2)
+    { 90,   110,  160,  260}, // FGR 4x (tRFC4)
+  };
+
+  // tREFI(base) table (unit is nanosecond!)
+  constexpr int tREFI_BASE = 7800;
+  int density_id = [](int density_Mb) -> int { 
+    switch (density_Mb) {
+      case 2048:  return 0;
+      case 4096:  return 1;
+      case 8192:  return 2;
+      case 16384: return 3;
+      default:    return -1;
+    }
+  }(density_Mb);
+
+  DDR4RefreshTimings timings;
+  if (density_id != -1) {
+    timings.nRFC = JEDEC_rounding(tRFC_TABLE[fgr_id][density_id], tCK_ps);
+  }
+  timings.nREFI = JEDEC_rounding(tREFI_BASE / fgr_mode, tCK_ps);
+  return timings;
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_DRAM_DDR4_REFRESH_H
@@ -16,7 +16,7 @@ namespace Bank {
   template <class T>
   void ACT(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
     node->m_state = T::m_states["Opened"];
-    node->m_row_state[target_id] = T::m_states["Opened"];
+    node->m_row_state.set_state(target_id, T::m_states["Opened"]);
   };
 
   template <class T>
@@ -35,6 +35,8 @@ namespace BankGroup {
         if (bank->m_node_id == target_id) {
           bank->m_state = T::m_states["Closed"];
           bank->m_row_state.clear();
+          // The banks in the other bankgroups are not on the path of the command
+          bank->mark_state_changed();
         }
       }
     }
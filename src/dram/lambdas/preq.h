@@ -12,7 +12,7 @@ int RequireRowOpen(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
   switch (node->m_state) {
     case T::m_states["Closed"]: return T::m_commands["ACT"];
     case T::m_states["Opened"]: {
-      if (node->m_row_state.find(target_id) != node->m_row_state.end()) {
+      if (node->m_row_state.contains(target_id)) {
         return cmd;
       } else {
         return T::m_commands["PRE"];
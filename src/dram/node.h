@@ -2,10 +2,11 @@
 #define RAMULATOR_DRAM_NODE_H
 
 #include <vector>
-#include <map>
-#include <deque>
+#include <array>
+#include <algorithm>
 #include <functional>
 #include <concepts>
+#include <utility>
 
 #include "base/type.h"
 #include "dram/spec.h"
@@ -26,13 +27,251 @@ concept IsDRAMSpec = requires(T t) {
 // };
 
 
+/**
+ * @brief     Fixed-capacity table of the open rows of a bank-ish node
+ * @details
+ * Most standards have at most one open row per bank, for which this is a single row id. Opening a row in a full table
+ * replaces the least recently opened one.
+ * 
+ */
+template<int N>
+class OpenRowTable {
+  static_assert(N > 0, "An open row table needs at least one entry.");
+
+  private:
+    std::array<int, N> m_rows;
+    std::array<int, N> m_states;
+    int m_size = 0;
+
+  public:
+    bool contains(int row) const {
+      for (int i = 0; i < m_size; i++) {
+        if (m_rows[i] == row) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    /**
+     * @brief    Returns the state of the row, or -1 if it is not open.
+     * 
+     */
+    int get_state(int row) const {
+      for (int i = 0; i < m_size; i++) {
+        if (m_rows[i] == row) {
+          return m_states[i];
+        }
+      }
+      return -1;
+    };
+
+    void set_state(int row, int state) {
+      for (int i = 0; i < m_size; i++) {
+        if (m_rows[i] == row) {
+          m_states[i] = state;
+          return;
+        }
+      }
+
+      if (m_size == N) {
+        std::move(m_rows.begin() + 1, m_rows.end(), m_rows.begin());
+        std::move(m_states.begin() + 1, m_states.end(), m_states.begin());
+        m_size--;
+      }
+      m_rows[m_size] = row;
+      m_states[m_size] = state;
+      m_size++;
+    };
+
+    void clear() { m_size = 0; };
+    int size() const { return m_size; };
+};
+
+/**
+ * @brief     How many rows can be open in a bank at the same time (a DRAM spec can override this with m_max_open_rows)
+ * 
+ */
+template<typename T>
+constexpr int max_open_rows() {
+  if constexpr (requires { T::m_max_open_rows; }) {
+    return T::m_max_open_rows;
+  } else {
+    return 1;
+  }
+};
+
+
+template<IsDRAMSpec T>
+struct DRAMNodeBase;
+
+/**
+ * @brief     Flattened storage of the node states, command ready clocks and command histories of a channel
+ * @details
+ * Every level of the hierarchy keeps its data in contiguous arrays. A node at a level is addressed by its flat id, i.e.,
+ * its position in the depth-first order of that level (parent_flat_id * level_size + node_id). The node objects
+ * themselves are also stored contiguously per level and only hold references into these arrays.
+ * 
+ */
+template<IsDRAMSpec T>
+struct DRAMNodeStore {
+  using NodeType = typename T::Node;
+
+  struct Level {
+    int size = 0;                       // Number of children of each node at the previous level
+    int num_nodes = 0;                  // Number of nodes at this level in the channel
+
+    std::vector<NodeType> nodes;        // The node objects (except the channel node, which is owned by the device)
+    std::vector<int> states;            // [node]
+    std::vector<uint64_t> state_versions;   // [node], the version of the last action performed at the node
+    std::vector<Clk_t> cmd_ready_clk;   // [node][command]
+
+    // Timing constraints of each command at this level, split into the ones on the target node and on its siblings
+    std::vector<int> target_cons_offset;          // [command + 1]
+    std::vector<TimingConsEntry> target_cons;
+    std::vector<int> sibling_cons_offset;         // [command + 1]
+    std::vector<TimingConsEntry> sibling_cons;
+
+    // Issue history of each command, kept as a circular buffer as long as the longest window of its constraints
+    std::vector<int> history_offset;    // Offset of the history of each command within the history of a node
+    std::vector<int> history_window;    // History length of each command
+    int history_size = 0;               // Total length of the history of a node
+    std::vector<Clk_t> cmd_history;     // [node][command][window]
+    std::vector<int> history_head;      // [node][command], position of the most recent entry
+  };
+
+  T* m_spec = nullptr;
+  int m_num_cmds = -1;
+  std::vector<Level> m_levels;
+  uint64_t m_state_version = 0;       // Number of actions performed in the channel so far
+
+  DRAMNodeStore(T* spec): m_spec(spec), m_num_cmds(T::m_commands.size()) {
+    // Only the levels above the rows are modeled as nodes
+    int last_level = T::m_levels["row"];
+    int num_nodes = 1;
+    for (int level = 0; level < last_level; level++) {
+      int size = level == 0 ? 1 : spec->m_organization.count[level];
+      if (size == 0) {
+        break;
+      }
+      num_nodes *= size;
+
+      Level& lvl = m_levels.emplace_back();
+      lvl.size = size;
+      lvl.num_nodes = num_nodes;
+      lvl.nodes.reserve(level == 0 ? 0 : num_nodes);
+      lvl.states.resize(num_nodes, spec->m_init_states[level]);
+      lvl.cmd_ready_clk.resize(num_nodes * m_num_cmds, -1);
+
+      lvl.target_cons_offset.push_back(0);
+      lvl.sibling_cons_offset.push_back(0);
+      lvl.history_offset.resize(m_num_cmds, 0);
+      lvl.history_window.resize(m_num_cmds, 0);
+      for (int cmd = 0; cmd < m_num_cmds; cmd++) {
+        int window = 0;
+        for (const auto& t : spec->m_timing_cons[level][cmd]) {
+          window = std::max(window, t.window);
+          if (t.sibling) {
+            lvl.sibling_cons.push_back(t);
+          } else {
+            lvl.target_cons.push_back(t);
+          }
+        }
+        lvl.target_cons_offset.push_back(lvl.target_cons.size());
+        lvl.sibling_cons_offset.push_back(lvl.sibling_cons.size());
+
+        lvl.history_offset[cmd] = lvl.history_size;
+        lvl.history_window[cmd] = window;
+        lvl.history_size += window;
+      }
+      lvl.cmd_history.resize(num_nodes * lvl.history_size, -1);
+      lvl.state_versions.resize(num_nodes, 0);
+      lvl.history_head.resize(num_nodes * m_num_cmds, 0);
+    }
+  };
+
+  int num_levels() const { return m_levels.size(); };
+
+  /**
+   * @brief    Reloads the latencies of the timing constraints after the spec changed their values (e.g., refresh mode).
+   * @details
+   * The spec must keep the same constraints in the same order, only their latencies can change.
+   * 
+   */
+  void update_timing_cons() {
+    for (int level = 0; level < num_levels(); level++) {
+      Level& lvl = m_levels[level];
+      int target_id = 0;
+      int sibling_id = 0;
+      for (int cmd = 0; cmd < m_num_cmds; cmd++) {
+        for (const auto& t : m_spec->m_timing_cons[level][cmd]) {
+          if (t.sibling) {
+            lvl.sibling_cons[sibling_id++].val = t.val;
+          } else {
+            lvl.target_cons[target_id++].val = t.val;
+          }
+        }
+      }
+    }
+  };
+
+  /**
+   * @brief    Applies the sibling timing constraints of the command to the given node.
+   * 
+   */
+  void update_sibling_timing(int level, int flat_id, int command, Clk_t clk) {
+    Level& lvl = m_levels[level];
+    Clk_t* cmd_ready_clk = &lvl.cmd_ready_clk[flat_id * m_num_cmds];
+    for (int i = lvl.sibling_cons_offset[command]; i < lvl.sibling_cons_offset[command + 1]; i++) {
+      const auto& t = lvl.sibling_cons[i];
+      cmd_ready_clk[t.cmd] = std::max(cmd_ready_clk[t.cmd], clk + t.val);
+    }
+  };
+
+  /**
+   * @brief    Records the command in the history of the given node and applies its timing constraints.
+   * 
+   */
+  void update_target_timing(int level, int flat_id, int command, Clk_t clk) {
+    Level& lvl = m_levels[level];
+    Clk_t* cmd_ready_clk = &lvl.cmd_ready_clk[flat_id * m_num_cmds];
+    Clk_t* history = &lvl.cmd_history[flat_id * lvl.history_size + lvl.history_offset[command]];
+    int& head = lvl.history_head[flat_id * m_num_cmds + command];
+
+    // The new entry overwrites the oldest one
+    int window = lvl.history_window[command];
+    if (window) {
+      head = (head == 0) ? window - 1 : head - 1;
+      history[head] = clk;
+    }
+
+    for (int i = lvl.target_cons_offset[command]; i < lvl.target_cons_offset[command + 1]; i++) {
+      const auto& t = lvl.target_cons[i];
+
+      // Get the oldest history within the window of this constraint
+      int pos = head + t.window - 1;
+      Clk_t past = history[pos < window ? pos : pos - window];
+      if (past < 0) {
+        // not enough history
+        continue;
+      }
+      cmd_ready_clk[t.cmd] = std::max(cmd_ready_clk[t.cmd], past + t.val);
+    }
+  };
+};
+
+
 /**
  * @brief     CRTP-ish (?) base class of a DRAM Device Node
+ * @details
+ * The nodes form a tree that the state machine lambdas can walk, but the timing information and states of all nodes
+ * in a channel live in a DRAMNodeStore owned by the channel node.
  * 
  */
 template<IsDRAMSpec T>
 struct DRAMNodeBase {
     using NodeType = typename T::Node;
+    using StoreType = DRAMNodeStore<T>;
     NodeType* m_parent_node = nullptr;
     std::vector<NodeType*> m_child_nodes;
 
@@ -42,57 +281,41 @@ struct DRAMNodeBase {
     int m_node_id = -1;    // The id of this node at this level
     int m_size = -1;       // The size of the node (e.g., how many rows in a bank)
 
-    int m_state = -1;      // The state of the node
+    StoreType* m_store = nullptr;   // The flattened storage of the channel this node belongs to
+    int m_flat_id = -1;             // The flat id of this node at this level within the channel
 
-    std::vector<Clk_t> m_cmd_ready_clk;             // The next cycle that each command can be issued again at this level
-    std::vector<std::deque<Clk_t>> m_cmd_history;   // Issue-history of each command at this level
+    int& m_state;          // The state of the node
+    Clk_t* m_cmd_ready_clk = nullptr;   // The next cycle that each command can be issued again at this level
 
-    using RowId_t = int;
-    using RowState_t = int;
-    std::map<RowId_t, RowState_t> m_row_state;  // The state of the rows, if I am a bank-ish node
+    OpenRowTable<max_open_rows<T>()> m_row_state;  // The state of the open rows, if I am a bank-ish node
 
     DRAMNodeBase(T* spec, NodeType* parent, int level, int id):
-    m_spec(spec), m_parent_node(parent), m_level(level), m_node_id(id) {
-      int num_cmds = T::m_commands.size();
-      m_cmd_ready_clk.resize(num_cmds, -1);
-      m_cmd_history.resize(num_cmds);
-      for (int cmd = 0; cmd < num_cmds; cmd++) {
-        int window = 0;
-        for (const auto& t : spec->m_timing_cons[level][cmd]) {
-          window = std::max(window, t.window);
-        }
-        if (window != 0) {
-          m_cmd_history[cmd].resize(window, -1);
-        } else {
-          m_cmd_history[cmd].clear();
-        }
-      }
-
-      m_state = spec->m_init_states[m_level];
-
+    m_parent_node(parent), m_spec(spec), m_level(level), m_node_id(id),
+    m_store(parent ? parent->m_store : new StoreType(spec)),
+    m_flat_id(parent ? parent->m_flat_id * m_store->m_levels[level].size + id : 0),
+    m_state(m_store->m_levels[level].states[m_flat_id]),
+    m_cmd_ready_clk(&m_store->m_levels[level].cmd_ready_clk[m_flat_id * m_store->m_num_cmds]) {
       // Recursively construct next levels
       int next_level = level + 1;
-      int last_level = T::m_levels["row"];
-      if (next_level == last_level) {
+      if (next_level == m_store->num_levels()) {
         return;
       } else {
-        int next_level_size = m_spec->m_organization.count[next_level];
-        if (next_level_size == 0) {
-          return;
-        } else {
-          for (int i = 0; i < next_level_size; i++) {
-            NodeType* child = new NodeType(spec, static_cast<NodeType*>(this), next_level, i);
-            static_cast<NodeType*>(this)->m_child_nodes.push_back(child);
-          }
+        int next_level_size = m_store->m_levels[next_level].size;
+        for (int i = 0; i < next_level_size; i++) {
+          NodeType& child = m_store->m_levels[next_level].nodes.emplace_back(spec, static_cast<NodeType*>(this), next_level, i);
+          m_child_nodes.push_back(&child);
         }
       }
     };
 
     void update_states(int command, const AddrVec_t& addr_vec, Clk_t clk) {
       int child_id = addr_vec[m_level+1];
-      if (m_spec->m_actions[m_level][command]) {
+      bool has_action = visit_func_table<&T::get_actions>(m_level, command, [&](auto action) {
         // update the state machine at this level
-        m_spec->m_actions[m_level][command](static_cast<NodeType*>(this), command, child_id, clk); 
+        action(static_cast<NodeType*>(this), command, child_id, clk);
+      });
+      if (has_action) {
+        mark_state_changed();
       }
       if (m_level == m_spec->m_command_scopes[command] || !m_child_nodes.size()) {
         // stop recursion: updated all levels
@@ -102,70 +325,55 @@ struct DRAMNodeBase {
       m_child_nodes[child_id]->update_states(command, addr_vec, clk);
     };
 
+    /**
+     * @brief    Gives the node a new state version, which invalidates the cached prerequisite commands on its paths
+     * @details
+     * update_states() marks the node that performs an action, which covers the changes to its descendants. An action
+     * that changes the states of any other node (e.g., the same bank in all bankgroups) must mark that node itself.
+     * 
+     */
+    void mark_state_changed() {
+      m_store->m_levels[m_level].state_versions[m_flat_id] = ++m_store->m_state_version;
+    };
+
     void update_timing(int command, const AddrVec_t& addr_vec, Clk_t clk) {
-      /************************************************
-       *         Update Sibling Node Timing
-       ***********************************************/
       if (m_node_id != addr_vec[m_level]) {
-        for (const auto& t : m_spec->m_timing_cons[m_level][command]) {
-          if (!t.sibling) {
-            // not sibling timing parameter
-            continue; 
-          }
-
-          // update earliest schedulable time of every command
-          Clk_t future = clk + t.val;
-          m_cmd_ready_clk[t.cmd] = std::max(m_cmd_ready_clk[t.cmd], future); 
-        }
-        // stop recursion: only target nodes should be recursed
-        return; 
-      }
-
-      /************************************************
-       *          Update Target Node Timing
-       ***********************************************/
-      // Update history
-      if (m_cmd_history[command].size()) {
-        m_cmd_history[command].pop_back();
-        m_cmd_history[command].push_front(clk); 
+        // Only the target nodes are recursed, the others only get the sibling timing constraints
+        m_store->update_sibling_timing(m_level, m_flat_id, command, clk);
+        return;
       }
-
-      for (const auto& t : m_spec->m_timing_cons[m_level][command]) {
-        if (t.sibling) {
-          continue; 
+      m_store->update_target_timing(m_level, m_flat_id, command, clk);
+
+      // Walk down the levels: the children of the target node are either the next target or its siblings
+      int flat_id = m_flat_id;
+      for (int level = m_level + 1; level < m_store->num_levels(); level++) {
+        int size = m_store->m_levels[level].size;
+        int target_id = addr_vec[level];
+        for (int id = 0; id < size; id++) {
+          if (id == target_id) {
+            m_store->update_target_timing(level, flat_id * size + id, command, clk);
+          } else {
+            m_store->update_sibling_timing(level, flat_id * size + id, command, clk);
+          }
         }
 
-        // Get the oldest history
-        Clk_t past = m_cmd_history[command][t.window-1];
-        if (past < 0) {
-          // not enough history
-          continue; 
+        if (target_id < 0) {
+          // stop recursion: no child is targeted
+          return;
         }
-
-        // update earliest schedulable time of every command
-        Clk_t future = past + t.val;
-        m_cmd_ready_clk[t.cmd] = std::max(m_cmd_ready_clk[t.cmd], future);
-      }
-
-      if (!m_child_nodes.size()) {
-        // stop recursion: updated all levels
-        return; 
-      }
-
-      // recursively update all of my children
-      for (auto child : m_child_nodes) {
-        child->update_timing(command, addr_vec, clk);
+        flat_id = flat_id * size + target_id;
       }
     };
 
     int get_preq_command(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
       int child_id = addr_vec[m_level + 1];
-      if (m_spec->m_preqs[m_level][command]) {
-        int preq_cmd = m_spec->m_preqs[m_level][command](static_cast<NodeType*>(this), command, child_id, m_clk);
-        if (preq_cmd != -1) {
-          // stop recursion: there is a prerequisite at this level
-          return preq_cmd; 
-        }
+      int preq_cmd = -1;
+      visit_func_table<&T::get_preqs>(m_level, command, [&](auto preq) {
+        preq_cmd = preq(static_cast<NodeType*>(this), command, child_id, m_clk);
+      });
+      if (preq_cmd != -1) {
+        // stop recursion: there is a prerequisite at this level
+        return preq_cmd; 
       }
 
       if (child_id < 0 || !m_child_nodes.size()) {
@@ -177,28 +385,73 @@ struct DRAMNodeBase {
       return m_child_nodes[child_id]->get_preq_command(command, addr_vec, m_clk);
     };
 
-    bool check_ready(int command, const AddrVec_t& addr_vec, Clk_t clk) {
-      if (m_cmd_ready_clk[command] != -1 && clk < m_cmd_ready_clk[command]) {
-        // stop recursion: the check failed at this level
-        return false; 
+    /**
+     * @brief    Returns the version of the most recent action performed at any node on the path to addr_vec
+     * @details
+     * An action may change the states of the node it is performed at and of its descendants, so the prerequisite
+     * command of a request cannot change as long as the version of its path stays the same.
+     * 
+     */
+    uint64_t get_state_version(const AddrVec_t& addr_vec) {
+      uint64_t version = 0;
+      int flat_id = m_flat_id;
+      for (int level = m_level;; level++) {
+        version = std::max(version, m_store->m_levels[level].state_versions[flat_id]);
+
+        int child_id = addr_vec[level+1];
+        if (child_id < 0 || level + 1 == m_store->num_levels()) {
+          return version;
+        }
+        flat_id = flat_id * m_store->m_levels[level+1].size + child_id;
       }
+    };
 
-      int child_id = addr_vec[m_level+1];
-      if (child_id < 0 || m_level == m_spec->m_command_scopes[command] || !m_child_nodes.size()) {
-        // stop recursion: the check passed at all levels
-        return true; 
+    /**
+     * @brief    Returns the cycle from which the timing constraints on the path allow the command (-1 if unconstrained)
+     * 
+     */
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) {
+      Clk_t ready_clk = -1;
+      int flat_id = m_flat_id;
+      for (int level = m_level;; level++) {
+        ready_clk = std::max(ready_clk, m_store->m_levels[level].cmd_ready_clk[flat_id * m_store->m_num_cmds + command]);
+
+        int child_id = addr_vec[level+1];
+        if (child_id < 0 || level == m_spec->m_command_scopes[command] || level + 1 == m_store->num_levels()) {
+          return ready_clk;
+        }
+        flat_id = flat_id * m_store->m_levels[level+1].size + child_id;
       }
+    };
+
+    bool check_ready(int command, const AddrVec_t& addr_vec, Clk_t clk) {
+      int flat_id = m_flat_id;
+      for (int level = m_level;; level++) {
+        Clk_t ready_clk = m_store->m_levels[level].cmd_ready_clk[flat_id * m_store->m_num_cmds + command];
+        if (ready_clk != -1 && clk < ready_clk) {
+          // stop: the check failed at this level
+          return false;
+        }
 
-      // recursively check my child
-      return m_child_nodes[child_id]->check_ready(command, addr_vec, clk);
+        int child_id = addr_vec[level+1];
+        if (child_id < 0 || level == m_spec->m_command_scopes[command] || level + 1 == m_store->num_levels()) {
+          // stop: the check passed at all levels
+          return true;
+        }
+        flat_id = flat_id * m_store->m_levels[level+1].size + child_id;
+      }
     };
 
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
       // TODO: Optimize this by just checking the bank-levels? Have a dedicated bank structure?
       int child_id = addr_vec[m_level+1];
-      if (m_spec->m_rowhits[m_level][command]) {
+      bool is_hit = false;
+      bool has_rowhit = visit_func_table<&T::get_rowhits>(m_level, command, [&](auto rowhit) {
+        is_hit = rowhit(static_cast<NodeType*>(this), command, child_id, m_clk);
+      });
+      if (has_rowhit) {
         // stop recursion: there is a row hit at this level
-        return m_spec->m_rowhits[m_level][command](static_cast<NodeType*>(this), command, child_id, m_clk);  
+        return is_hit;
       }
 
       if (child_id < 0 || !m_child_nodes.size()) {
@@ -208,26 +461,78 @@ struct DRAMNodeBase {
 
       // recursively check for row hits at my child
       return m_child_nodes[child_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
+    };
+
+    bool check_node_open(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
+      int child_id = addr_vec[m_level+1];
+      bool is_open = false;
+      bool has_rowopen = visit_func_table<&T::get_rowopens>(m_level, command, [&](auto rowopen) {
+        is_open = rowopen(static_cast<NodeType*>(this), command, child_id, m_clk);
+      });
+      if (has_rowopen) {
+        // stop recursion: the node that the command accesses decides whether it is open
+        return is_open;
+      }
+
+      if (child_id < 0 || !m_child_nodes.size()) {
+        // stop recursion: there were no open nodes at any level
+        return false;
+      }
+
+      // recursively check for open nodes at my child
+      return m_child_nodes[child_id]->check_node_open(command, addr_vec, m_clk);
     };    
 };
 
+// The behavior tables are built at compile time, so they hold plain function pointers (i.e., the lambdas must not capture anything).
 template<class T>
-using ActionFunc_t = std::function<void(typename T::Node* node, int cmd, int target_id, Clk_t clk)>;
+using ActionFunc_t = void (*)(typename T::Node* node, int cmd, int target_id, Clk_t clk);
 template<class T>
-using PreqFunc_t   = std::function<int (typename T::Node* node, int cmd, int target_id, Clk_t clk)>;
+using PreqFunc_t   = int  (*)(typename T::Node* node, int cmd, int target_id, Clk_t clk);
 template<class T>
-using RowhitFunc_t = std::function<bool(typename T::Node* node, int cmd, int target_id, Clk_t clk)>;
+using RowhitFunc_t = bool (*)(typename T::Node* node, int cmd, int target_id, Clk_t clk);
 template<class T>
 using RowopenFunc_t = RowhitFunc_t<T>;
 
-template<typename T>
-using FuncMatrix = std::vector<std::vector<T>>;
+/**
+ * @brief    A constexpr [level][command] table of function pointers
+ * @details
+ * Every standard returns its tables from static constexpr get_actions(), get_preqs(), get_rowhits() and get_rowopens().
+ * 
+ */
+template<typename F, int num_levels, int num_commands>
+struct FuncTable {
+  std::array<F, num_levels * num_commands> funcs{};
 
-// TODO: Enable easy syntax for FuncMatrix lookup
-// template<typename T, int N, int M>
-// class FuncMatrix : public std::array<std::array<T, M>, N> {
+  constexpr F* operator[](int level) { return funcs.data() + level * num_commands; };
+  constexpr int get_index(int level, int command) const { return level * num_commands + command; };
+};
 
-// };
+template<auto func, typename Visitor>
+inline bool visit_func(Visitor& visitor) {
+  if constexpr (func == nullptr) {
+    return false;
+  } else {
+    visitor(func);
+    return true;
+  }
+}
+
+/**
+ * @brief    Calls visitor(func) with the function of the given level and command in a constexpr table (if any)
+ * @details
+ * The table is a template argument and the lookup is unrolled over its entries, so the visitor calls a
+ * compile-time constant function that the compiler can inline. Returns whether the table has a function.
+ * 
+ */
+template<auto get_table, typename Visitor>
+inline bool visit_func_table(int level, int command, Visitor&& visitor) {
+  static constexpr auto table = get_table();
+  int index = table.get_index(level, command);
+  return [&]<size_t... I>(std::index_sequence<I...>) {
+    return ((index == I && visit_func<table.funcs[I]>(visitor)) || ...);
+  }(std::make_index_sequence<table.funcs.size()>());
+}
 
 }        // namespace Ramulator
 
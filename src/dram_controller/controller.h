@@ -12,6 +12,8 @@
 #include "dram_controller/scheduler.h"
 #include "dram_controller/plugin.h"
 #include "dram_controller/refresh.h"
+#include "dram_controller/row_policy.h"
+#include "dram_controller/write_drain_policy.h"
 
 
 namespace Ramulator {
@@ -23,6 +25,8 @@ class IDRAMController : public Clocked<IDRAMController> {
     IDRAM*  m_dram = nullptr;          
     IScheduler*   m_scheduler = nullptr;
     IRefreshManager*   m_refresh = nullptr;
+    IRowPolicy*   m_row_policy = nullptr;
+    IWriteDrainPolicy*   m_write_drain = nullptr;
 
     int m_channel_id = -1;
   public:
@@ -41,12 +45,64 @@ class IDRAMController : public Clocked<IDRAMController> {
      */
     virtual bool priority_send(Request& req) = 0;
 
+    /**
+     * @brief       Returns the number of buffered (demand) requests whose address matches addr_vec down to the given level.
+     * 
+     */
+    virtual size_t get_num_buffered_requests(const AddrVec_t& addr_vec, int level) { return 0; };
+
     /**
      * @brief       Ticks the memory controller.
      * 
      */
     virtual void tick() = 0;
-   
+
+    /**
+     * @brief       Returns the earliest cycle at which ticking the controller can change its state (-1 if unknown).
+     *
+     */
+    virtual Clk_t get_next_event_clk() { return -1; };
+
+    /**
+     * @brief       Returns the earliest cycle at which any buffered request can issue its next command (-1 if unknown).
+     *
+     */
+    virtual Clk_t get_next_issue_clk() { return -1; };
+
+    /**
+     * @brief       Returns the earliest cycle at which ticking the controller can call a request's callback (-1 if unknown).
+     *
+     */
+    virtual Clk_t get_next_callback_clk() { return -1; };
+
+    /**
+     * @brief       Advances the controller by num_cycles idle cycles without ticking it.
+     *
+     */
+    virtual void fast_forward(Clk_t num_cycles) { m_clk += num_cycles; };
+
+    /**
+     * @brief       Updates the prerequisite command cached in a row queue and returns whether it can be issued now.
+     * @details
+     * The requests of a row queue share the same prerequisite command, which is cached until an action changes
+     * the states on the path of the row. Timing constraints only ever postpone the ready cycle of a command, so
+     * a cached command that could not be issued before a given cycle does not need to be checked again until then.
+     *
+     */
+    bool update_row_queue_command(ReqBuffer& buffer, int queue_id) {
+      auto& queue = buffer.row_queues[queue_id];
+      auto head = buffer.row_queue_head(queue_id);
+      uint64_t state_version = m_dram->get_state_version(head->addr_vec);
+      if (queue.command != -1 && queue.state_version == state_version && m_clk < queue.earliest_issue_clk) {
+        return false;
+      }
+
+      queue.command = m_dram->get_preq_command(head->final_command, head->addr_vec);
+      queue.state_version = state_version;
+      bool ready = m_dram->check_ready(queue.command, head->addr_vec);
+      queue.earliest_issue_clk = ready ? m_clk : m_dram->get_earliest_issue_clk(queue.command, head->addr_vec);
+      return ready;
+    };
 };
 
 }       // namespace Ramulator
@@ -1,29 +1,119 @@
+#include <map>
+#include <unordered_map>
+
 #include "dram_controller/controller.h"
 #include "memory_system/memory_system.h"
 
 namespace Ramulator {
 
+/**
+ * @brief    Latency histograms of the requests served by a controller
+ * 
+ */
+struct RequestLatencies {
+  LatencyHistogram queueing;    // From arriving at the controller to issuing the first command
+  LatencyHistogram service;     // From issuing the first command to departing the controller
+  LatencyHistogram total;       // From arriving at the controller to departing the controller
+
+  void add(const Request& req) {
+    queueing.add(req.issue - req.arrive);
+    service.add(req.depart - req.issue);
+    total.add(req.depart - req.arrive);
+  };
+};
+
+YAML::Emitter& operator << (YAML::Emitter& emitter, const RequestLatencies& latencies) {
+  emitter << YAML::BeginMap;
+  emitter << YAML::Key << "queueing" << YAML::Value << latencies.queueing;
+  emitter << YAML::Key << "service" << YAML::Value << latencies.service;
+  emitter << YAML::Key << "total" << YAML::Value << latencies.total;
+  emitter << YAML::EndMap;
+  return emitter;
+}
+
 class GenericDRAMController final : public IDRAMController, public Implementation {
   RAMULATOR_REGISTER_IMPLEMENTATION(IDRAMController, GenericDRAMController, "Generic", "A generic DRAM controller.");
   private:
-    std::deque<Request> pending;          // A queue for read requests that are about to finish (callback after RL)
+    struct PendingRequest {
+      Request req;
+      size_t seq;                         // Keeps requests that depart in the same cycle in the order they became pending
+    };
+    struct DepartsLater {
+      bool operator()(const PendingRequest& lhs, const PendingRequest& rhs) const {
+        return lhs.req.depart > rhs.req.depart || (lhs.req.depart == rhs.req.depart && lhs.seq > rhs.seq);
+      }
+    };
+    std::vector<PendingRequest> pending;  // A min-heap (on the depart cycle) for requests that are about to finish (e.g., reads: callback after RL)
+    size_t m_pending_seq = 0;
 
     ReqBuffer m_active_buffer;            // Buffer for requests being served. This has the highest priority 
-    ReqBuffer m_priority_buffer;          // Buffer for high-priority requests (e.g., maintenance like refresh).
-    ReqBuffer m_read_buffer;              // Read request buffer
-    ReqBuffer m_write_buffer;             // Write request buffer
+    ReqBuffer m_priority_buffer;          // Buffer for high-priority requests (e.g., maintenance like refresh). Each only blocks the ranks or banks it needs
+    ReqBuffer m_read_buffer;              // Read request buffer (indexed by row)
+    ReqBuffer m_write_buffer;             // Write request buffer (indexed by row)
+    std::unordered_map<Addr_t, int> m_write_addrs;    // Number of requests in the write buffer to each address (for forwarding)
 
     int m_row_addr_idx = -1;
 
     float m_wr_low_watermark;
     float m_wr_high_watermark;
     bool  m_is_write_mode = false;
+    Clk_t m_mode_switch_clk = 0;          // The cycle at which the controller last switched between read and write mode
+
+    // When the callback of a write request is called
+    enum class WriteAck {
+      None,                               // Never (writes are posted)
+      Enqueue,                            // As soon as the write is accepted into the write buffer
+      Written,                            // When the data of the write is written to the device
+    } m_write_ack = WriteAck::None;
 
     std::vector<IControllerPlugin*> m_plugins;
 
+    std::vector<int> m_auto_precharge_commands;   // The command that also closes the row after an access (e.g., RD -> RDA), -1 if none
+    int m_pre_command = -1;
+
+    int m_rank_addr_idx = -1;
+    int m_bank_addr_idx = -1;
+    int m_num_banks = -1;                 // Number of banks in the channel
+    std::vector<Clk_t> m_bank_open_clk;   // The cycle at which the open row of each bank was opened (-1 if closed)
+
     size_t s_num_row_hits = 0;
     size_t s_num_row_misses = 0;
     size_t s_num_row_conflicts = 0;
+    std::vector<size_t> s_bank_row_hits;
+    std::vector<size_t> s_bank_row_misses;
+    std::vector<size_t> s_bank_row_conflicts;
+    std::vector<size_t> s_bank_busy_cycles;
+    std::vector<float> s_bank_utilization;
+    std::vector<size_t> s_rank_num_acts;
+    std::vector<float> s_rank_acts_per_kcycle;
+    size_t s_data_bus_busy_cycles = 0;
+    float s_data_bus_utilization = 0;
+
+    std::vector<bool> m_is_write_command;  // Whether each column command writes data
+    int m_last_column_direction = -1;     // 0 = Read, 1 = Write (-1 before the first column command)
+    Clk_t m_last_burst_end_clk = -1;      // The cycle at which the data burst of the last column command ends
+    size_t s_num_write_drains = 0;
+    float s_avg_writes_per_drain = 0;
+    size_t s_num_read_to_write_turnarounds = 0;
+    size_t s_num_write_to_read_turnarounds = 0;
+    size_t s_turnaround_cycles = 0;
+    float s_turnaround_bus_fraction = 0;
+
+    int m_access_bytes = -1;              // Number of bytes transferred by a read or write request
+    size_t s_num_forwarded_reads = 0;
+    size_t s_forwarded_read_bytes = 0;
+
+    size_t s_num_served_writes = 0;
+    Clk_t m_total_write_queueing_latency = 0;   // From arriving at the controller to issuing the first command
+    Clk_t m_total_write_service_latency = 0;    // From issuing the first command to the data being written
+    float s_avg_write_queueing_latency = 0;
+    float s_avg_write_service_latency = 0;
+
+    // Latencies of the requests that are served from the read and write buffers (i.e., not forwarded)
+    RequestLatencies s_read_latency;
+    RequestLatencies s_write_latency;
+    std::map<int, RequestLatencies> s_read_latency_per_source;
+    std::map<int, RequestLatencies> s_write_latency_per_source;
 
 
   public:
@@ -31,8 +121,37 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       m_wr_low_watermark =  param<float>("wr_low_watermark").desc("Threshold for switching back to read mode.").default_val(0.2f);
       m_wr_high_watermark = param<float>("wr_high_watermark").desc("Threshold for switching to write mode.").default_val(0.8f);
 
+      std::string write_ack = param<std::string>("write_ack").desc("When to call the callback of a write request (none, enqueue, or written).").default_val("none");
+      if (write_ack == "none") {
+        m_write_ack = WriteAck::None;
+      } else if (write_ack == "enqueue") {
+        m_write_ack = WriteAck::Enqueue;
+      } else if (write_ack == "written") {
+        m_write_ack = WriteAck::Written;
+      } else {
+        throw ConfigurationError("Unknown write_ack {} (should be none, enqueue, or written)!", write_ack);
+      }
+
       m_scheduler = create_child_ifce<IScheduler>();
       m_refresh = create_child_ifce<IRefreshManager>();    
+      // Without a row policy, rows stay open until a conflict (i.e., open-page policy)
+      if (m_config["RowPolicy"]) {
+        m_row_policy = create_child_ifce<IRowPolicy>();
+      }
+      // Without a write drain policy, the controller switches between read and write mode on the watermarks
+      if (m_config["WriteDrainPolicy"]) {
+        m_write_drain = create_child_ifce<IWriteDrainPolicy>();
+      }
+
+      register_stat(s_num_forwarded_reads).name("num_forwarded_reads");
+      register_stat(s_forwarded_read_bytes).name("forwarded_read_bytes");
+      register_stat(s_num_served_writes).name("num_served_writes");
+      register_stat(s_avg_write_queueing_latency).name("avg_write_queueing_latency");
+      register_stat(s_avg_write_service_latency).name("avg_write_service_latency");
+      register_stat(s_read_latency).name("read_latency");
+      register_stat(s_write_latency).name("write_latency");
+      register_stat(s_read_latency_per_source).name("read_latency_per_source");
+      register_stat(s_write_latency_per_source).name("write_latency_per_source");
 
       if (m_config["plugins"]) {
         YAML::Node plugin_configs = m_config["plugins"];
@@ -45,7 +164,74 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
       m_dram = memory_system->get_ifce<IDRAM>();
       m_row_addr_idx = m_dram->m_levels("row");
+      m_access_bytes = m_dram->m_internal_prefetch_size * m_dram->m_channel_width / 8;
       m_priority_buffer.max_size = 512*128 + 32;
+
+      // The auto-precharge variant of a command is named with an "A" suffix (e.g., RDA, WRA, RD16A)
+      m_auto_precharge_commands.resize(m_dram->m_commands.size(), -1);
+      for (int command = 0; command < m_dram->m_commands.size(); command++) {
+        if (!m_dram->m_command_meta(command).is_accessing || m_dram->m_command_meta(command).is_closing) {
+          continue;
+        }
+        try {
+          int auto_precharge_command = m_dram->m_commands(std::string(m_dram->m_commands(command)) + "A");
+          if (m_dram->m_command_meta(auto_precharge_command).is_closing) {
+            m_auto_precharge_commands[command] = auto_precharge_command;
+          }
+        } catch (const std::out_of_range& e) {
+          continue;
+        }
+      }
+      m_pre_command = m_dram->m_commands("PRE");
+
+      m_is_write_command.resize(m_dram->m_commands.size(), false);
+      int write_command = m_dram->m_request_translations(Request::Type::Write);
+      m_is_write_command[write_command] = true;
+      if (m_auto_precharge_commands[write_command] != -1) {
+        m_is_write_command[m_auto_precharge_commands[write_command]] = true;
+      }
+
+      // Flat bank ids cover the levels between the channel and the bank (each controller serves one channel)
+      m_bank_addr_idx = m_dram->m_levels("bank");
+      try {
+        m_rank_addr_idx = m_dram->m_levels("rank");
+      } catch (const std::out_of_range& e) {
+        // Standards without ranks (e.g., HBM) report the level right below the channel instead
+        m_rank_addr_idx = 1;
+      }
+      m_num_banks = m_dram->get_num_flat_ids(m_bank_addr_idx);
+      m_bank_open_clk.resize(m_num_banks, -1);
+      s_bank_row_hits.resize(m_num_banks, 0);
+      s_bank_row_misses.resize(m_num_banks, 0);
+      s_bank_row_conflicts.resize(m_num_banks, 0);
+      s_bank_busy_cycles.resize(m_num_banks, 0);
+      s_bank_utilization.resize(m_num_banks, 0);
+      s_rank_num_acts.resize(m_dram->m_organization.count[m_rank_addr_idx], 0);
+      s_rank_acts_per_kcycle.resize(m_dram->m_organization.count[m_rank_addr_idx], 0);
+
+      register_stat(s_num_row_hits).name("num_row_hits");
+      register_stat(s_num_row_misses).name("num_row_misses");
+      register_stat(s_num_row_conflicts).name("num_row_conflicts");
+      register_stat(s_bank_row_hits).name("bank_row_hits");
+      register_stat(s_bank_row_misses).name("bank_row_misses");
+      register_stat(s_bank_row_conflicts).name("bank_row_conflicts");
+      register_stat(s_bank_busy_cycles).name("bank_busy_cycles").desc("Cycles in which the bank has an open row");
+      register_stat(s_bank_utilization).name("bank_utilization");
+      register_stat(s_rank_num_acts).name("rank_num_acts");
+      register_stat(s_rank_acts_per_kcycle).name("rank_acts_per_kcycle");
+      register_stat(s_data_bus_busy_cycles).name("data_bus_busy_cycles");
+      register_stat(s_data_bus_utilization).name("data_bus_utilization");
+      register_stat(s_num_write_drains).name("num_write_drains").desc("Number of switches from read to write mode");
+      register_stat(s_avg_writes_per_drain).name("avg_writes_per_drain");
+      register_stat(s_num_read_to_write_turnarounds).name("num_read_to_write_turnarounds");
+      register_stat(s_num_write_to_read_turnarounds).name("num_write_to_read_turnarounds");
+      register_stat(s_turnaround_cycles).name("turnaround_cycles").desc("Data bus cycles lost when switching between reads and writes");
+      register_stat(s_turnaround_bus_fraction).name("turnaround_bus_fraction");
+
+      // Index the read and write buffers by row so that the scheduler only looks at one request per row
+      std::vector<int> row_key_level_sizes(m_dram->m_organization.count.begin(), m_dram->m_organization.count.begin() + m_row_addr_idx + 1);
+      m_read_buffer.index_by_row(row_key_level_sizes);
+      m_write_buffer.index_by_row(row_key_level_sizes);
     };
 
     bool send(Request& req) override {
@@ -53,13 +239,12 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
       // Forward existing write requests to incoming read requests
       if (req.type_id == Request::Type::Read) {
-        auto compare_addr = [req](const Request& wreq) {
-          return wreq.addr == req.addr;
-        };
-        if (std::find_if(m_write_buffer.begin(), m_write_buffer.end(), compare_addr) != m_write_buffer.end()) {
+        if (m_write_addrs.count(req.addr)) {
           // The request will depart at the next cycle
           req.depart = m_clk + 1;
-          pending.push_back(req);
+          add_pending(Request(req));
+          s_num_forwarded_reads++;
+          s_forwarded_read_bytes += m_access_bytes;
           return true;
         }
       }
@@ -70,7 +255,20 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       if        (req.type_id == Request::Type::Read) {
         is_success = m_read_buffer.enqueue(req);
       } else if (req.type_id == Request::Type::Write) {
-        is_success = m_write_buffer.enqueue(req);
+        Request write_req(req);
+        if (m_write_ack == WriteAck::Enqueue) {
+          // Acknowledged below, so that the callback is not called again once the data is written
+          write_req.callback = nullptr;
+        }
+        is_success = m_write_buffer.enqueue(std::move(write_req));
+        if (is_success) {
+          m_write_addrs[req.addr]++;
+          if (m_write_ack == WriteAck::Enqueue && req.callback) {
+            // The callback is called at the next cycle (as for forwarded reads)
+            req.depart = m_clk + 1;
+            add_pending(Request(req));
+          }
+        }
       } else {
         throw std::runtime_error("Invalid request type!");
       }
@@ -83,6 +281,18 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       return true;
     };
 
+    size_t get_num_buffered_requests(const AddrVec_t& addr_vec, int level) override {
+      size_t num_reqs = 0;
+      for (auto buffer : {&m_active_buffer, &m_read_buffer, &m_write_buffer}) {
+        for (auto& req : *buffer) {
+          if (req.addr_vec.same_prefix(addr_vec, level + 1)) {
+            num_reqs++;
+          }
+        }
+      }
+      return num_reqs;
+    };
+
     bool priority_send(Request& req) override {
       req.final_command = m_dram->m_request_translations(req.type_id);
 
@@ -94,8 +304,8 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
     void tick() override {
       m_clk++;
 
-      // 1. Serve completed reads
-      serve_completed_reads();
+      // 1. Serve completed requests
+      serve_completed_requests();
 
       m_refresh->tick();
 
@@ -106,7 +316,11 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
       // Only cache: observe reads/writes, update table, priority queue for write-backs
       // Cache + Mithril: observe all reqs, act -> save row id, read/write -> check miss, call mithril on 1st miss, clear row id on pre
-      // 3. Update all plugins
+      // 3. Update the scheduler and all plugins
+      m_scheduler->update(request_found, req_it);
+      if (m_write_drain) {
+        m_write_drain->update(request_found, req_it);
+      }
       for (auto plugin : m_plugins) {
         plugin->update(request_found, req_it);
       }
@@ -114,56 +328,356 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       // 4. Finally, issue the commands to serve the request
       if (request_found) {
         // If we find a real request to serve
-        m_dram->issue_command(req_it->command, req_it->addr_vec);
+        if (req_it->issue == -1) {
+          req_it->issue = m_clk;
+          update_request_stats(*req_it);
+        }
+        issue_command(req_it->command, req_it->addr_vec);
 
         // If we are issuing the last command, set depart clock cycle and move the request to the pending queue
-        if (req_it->command == req_it->final_command) {
+        if (is_final_command(*req_it)) {
           if (req_it->type_id == Request::Type::Read) {
             req_it->depart = m_clk + m_dram->m_read_latency;
-            pending.push_back(*req_it);
+            if (req_it->arrive != -1) {
+              s_read_latency.add(*req_it);
+              s_read_latency_per_source[req_it->source_id].add(*req_it);
+            }
+            add_pending(std::move(*req_it));
           } else if (req_it->type_id == Request::Type::Write) {
-            // TODO: Add code to update statistics
+            req_it->depart = m_clk + m_dram->m_write_latency;
+            if (req_it->arrive != -1) {
+              // Only count the writes from the frontend (maintenance writes bypass the write buffer)
+              s_num_served_writes++;
+              m_total_write_queueing_latency += req_it->issue - req_it->arrive;
+              m_total_write_service_latency += req_it->depart - req_it->issue;
+              s_write_latency.add(*req_it);
+              s_write_latency_per_source[req_it->source_id].add(*req_it);
+            }
+            if (m_write_ack == WriteAck::Written && req_it->callback) {
+              add_pending(std::move(*req_it));
+            }
           }
-          buffer->remove(req_it);
+          remove_request(buffer, req_it);
         } else {
           if (m_dram->m_command_meta(req_it->command).is_opening) {
-            m_active_buffer.enqueue(*req_it);
-            buffer->remove(req_it);
+            m_active_buffer.enqueue(std::move(*req_it));
+            remove_request(buffer, req_it);
+          }
+        }
+
+      } else if (m_row_policy) {
+        // Let the row policy close a row that is no longer needed while no request can be served
+        issue_idle_precharge();
+      }
+
+    };
+
+    Clk_t get_next_issue_clk() override {
+      Clk_t next_clk = no_event_clk;
+      auto update_next_clk = [this, &next_clk](Request& req) {
+        int command = m_dram->get_preq_command(req.final_command, req.addr_vec);
+        next_clk = std::min(next_clk, m_dram->get_earliest_issue_clk(command, req.addr_vec));
+      };
+
+      for (auto& req : m_active_buffer) {
+        update_next_clk(req);
+      }
+      for (auto it = m_priority_buffer.begin(); it != m_priority_buffer.end(); it++) {
+        if (!is_blocked(it->addr_vec, it)) {
+          update_next_clk(*it);
+        }
+      }
+      // Requests to the same row can issue at the same cycle, so the cycle cached in the row queue (shared with the
+      // scheduler) covers all of them. A blocked request cannot issue before the maintenance request that blocks it,
+      // which is an event on its own.
+      for (auto buffer : {&m_read_buffer, &m_write_buffer}) {
+        for (int queue_id : buffer->active_row_queues) {
+          auto head = buffer->row_queue_head(queue_id);
+          if (!is_blocked(head->addr_vec, m_priority_buffer.end())) {
+            update_row_queue_command(*buffer, queue_id);
+            next_clk = std::min(next_clk, buffer->row_queues[queue_id].earliest_issue_clk);
+          }
+        }
+      }
+      return next_clk;
+    };
+
+    Clk_t get_next_event_clk() override {
+      // A plugin observes every cycle
+      if (m_plugins.size()) {
+        return m_clk + 1;
+      }
+
+      Clk_t next_clk = m_refresh->get_next_event_clk();
+      if (next_clk == -1) {
+        return m_clk + 1;
+      }
+      // Until a buffered request can issue, ticking only re-evaluates the same (unready) commands
+      next_clk = std::min(next_clk, get_next_issue_clk());
+      if (m_row_policy) {
+        Clk_t policy_clk = m_row_policy->get_next_event_clk();
+        if (policy_clk == -1) {
+          return m_clk + 1;
+        }
+        next_clk = std::min(next_clk, policy_clk);
+      }
+      if (m_write_drain) {
+        Clk_t drain_clk = m_write_drain->get_next_event_clk();
+        if (drain_clk == -1) {
+          return m_clk + 1;
+        }
+        next_clk = std::min(next_clk, drain_clk);
+      }
+      if (pending.size()) {
+        next_clk = std::min(next_clk, pending.front().req.depart);
+      }
+      return std::max(next_clk, m_clk + 1);
+    };
+
+    Clk_t get_next_callback_clk() override {
+      // Plugins may send requests (with callbacks) through the controller at any cycle
+      if (m_plugins.size()) {
+        return m_clk + 1;
+      }
+
+      Clk_t next_clk = no_event_clk;
+      for (const auto& pending_req : pending) {
+        if (pending_req.req.callback) {
+          next_clk = std::min(next_clk, pending_req.req.depart);
+        }
+      }
+      // A buffered request that issues its last command at the next cycle departs after the read (or write) latency
+      for (ReqBuffer* buffer : {&m_active_buffer, &m_priority_buffer, &m_read_buffer, &m_write_buffer}) {
+        for (const Request& req : *buffer) {
+          if (req.callback) {
+            next_clk = std::min(next_clk, m_clk + 1 + std::min(m_dram->m_read_latency, m_dram->m_write_latency));
+            break;
           }
         }
+      }
+      return next_clk == no_event_clk ? next_clk : std::max(next_clk, m_clk + 1);
+    };
+
+    void finalize() override {
+      if (m_clk > 0) {
+        for (int bank_id = 0; bank_id < m_num_banks; bank_id++) {
+          if (m_bank_open_clk[bank_id] != -1) {
+            s_bank_busy_cycles[bank_id] += m_clk - m_bank_open_clk[bank_id];
+          }
+          s_bank_utilization[bank_id] = (float) s_bank_busy_cycles[bank_id] / m_clk;
+        }
+        for (int rank_id = 0; rank_id < s_rank_num_acts.size(); rank_id++) {
+          s_rank_acts_per_kcycle[rank_id] = 1000.0f * s_rank_num_acts[rank_id] / m_clk;
+        }
+        s_data_bus_utilization = (float) s_data_bus_busy_cycles / m_clk;
+        s_turnaround_bus_fraction = (float) s_turnaround_cycles / m_clk;
+      }
+      if (s_num_write_drains) {
+        s_avg_writes_per_drain = (float) s_num_served_writes / s_num_write_drains;
+      }
 
+      if (s_num_served_writes) {
+        s_avg_write_queueing_latency = (float) m_total_write_queueing_latency / s_num_served_writes;
+        s_avg_write_service_latency = (float) m_total_write_service_latency / s_num_served_writes;
       }
+    };
 
+    void fast_forward(Clk_t num_cycles) override {
+      m_clk += num_cycles;
+      m_refresh->fast_forward(num_cycles);
+      // An idle tick still lets the write policy react to the buffers
+      set_write_mode();
     };
 
 
   private:
     /**
-     * @brief    Helper function to serve the completed read requests
-     * @details
-     * This function is called at the beginning of the tick() function.
-     * It checks the pending queue to see if the top request has received data from DRAM.
-     * If so, it finishes this request by calling its callback and poping it from the pending queue.
+     * @brief    Removes a (possibly moved-from) request from its buffer and keeps the write address index up to date
+     * 
      */
-    void serve_completed_reads() {
-      if (pending.size()) {
-        // Check the first pending request
-        auto& req = pending[0];
-        if (req.depart <= m_clk) {
-          // Request received data from dram
-          if (req.depart - req.arrive > 1) {
-            // Check if this requests accesses the DRAM or is being forwarded.
-            // TODO add the stats back
-          }
+    void remove_request(ReqBuffer* buffer, ReqBuffer::iterator req_it) {
+      if (buffer == &m_write_buffer) {
+        auto addr_it = m_write_addrs.find(req_it->addr);
+        if (--addr_it->second == 0) {
+          m_write_addrs.erase(addr_it);
+        }
+      }
+      buffer->remove(req_it);
+    };
 
-          if (req.callback) {
-            // If the request comes from outside (e.g., processor), call its callback
-            req.callback(req);
+    void issue_command(int command, const AddrVec_t& addr_vec) {
+      m_dram->issue_command(command, addr_vec);
+      update_command_stats(command, addr_vec);
+      if (m_row_policy) {
+        m_row_policy->update(command, addr_vec);
+      }
+    };
+
+    bool is_final_command(const Request& req) const {
+      return req.command == req.final_command || req.command == m_auto_precharge_commands[req.final_command];
+    };
+
+    /**
+     * @brief    Checks whether a buffered request other than the given one accesses the row of the address
+     * 
+     */
+    bool is_row_needed(const AddrVec_t& addr_vec, ReqBuffer::iterator except) {
+      int len = m_row_addr_idx + 1;
+      for (auto it = m_active_buffer.begin(); it != m_active_buffer.end(); it++) {
+        if (it != except && it->addr_vec.same_prefix(addr_vec, len)) {
+          return true;
+        }
+      }
+      // The requests of a row queue all access the same row
+      for (auto buffer : {&m_read_buffer, &m_write_buffer}) {
+        for (int queue_id : buffer->active_row_queues) {
+          auto head = buffer->row_queue_head(queue_id);
+          if (head->addr_vec.same_prefix(addr_vec, len)) {
+            const auto& queue = buffer->row_queues[queue_id];
+            if (head != except || queue.head != queue.tail) {
+              return true;
+            }
           }
-          // Finally, remove this request from the pending queue
-          pending.pop_front();
         }
+      }
+      return false;
+    };
+
+    void issue_idle_precharge() {
+      AddrVec_t addr_vec;
+      auto can_precharge = [this](const AddrVec_t& addr_vec) {
+        return !is_row_needed(addr_vec, m_active_buffer.end()) && m_dram->check_ready(m_pre_command, addr_vec);
       };
+      if (m_row_policy->get_idle_precharge(addr_vec, can_precharge)) {
+        issue_command(m_pre_command, addr_vec);
+      }
+    };
+
+    /**
+     * @brief    Classifies a read or write request as a row hit, miss, or conflict when its first command is issued
+     * 
+     */
+    void update_request_stats(const Request& req) {
+      if (req.type_id != Request::Type::Read && req.type_id != Request::Type::Write) {
+        return;
+      }
+
+      int bank_id = m_dram->get_flat_id(req.addr_vec, m_bank_addr_idx);
+      if (m_dram->check_rowbuffer_hit(req.final_command, req.addr_vec)) {
+        s_num_row_hits++;
+        s_bank_row_hits[bank_id]++;
+      } else if (m_dram->check_node_open(req.final_command, req.addr_vec)) {
+        s_num_row_conflicts++;
+        s_bank_row_conflicts[bank_id]++;
+      } else {
+        s_num_row_misses++;
+        s_bank_row_misses[bank_id]++;
+      }
+    };
+
+    /**
+     * @brief    Updates the bank, rank, and data bus statistics after issuing a command
+     * 
+     */
+    void update_command_stats(int command, const AddrVec_t& addr_vec) {
+      const DRAMCommandMeta& meta = m_dram->m_command_meta(command);
+      if (meta.is_accessing) {
+        s_data_bus_busy_cycles += m_dram->m_burst_cycles;
+        update_turnaround_stats(command);
+      }
+      if (meta.is_opening) {
+        int bank_id = m_dram->get_flat_id(addr_vec, m_bank_addr_idx);
+        if (m_bank_open_clk[bank_id] == -1) {
+          m_bank_open_clk[bank_id] = m_clk;
+        }
+        s_rank_num_acts[addr_vec[m_rank_addr_idx]]++;
+      }
+      if (meta.is_closing) {
+        // A closing command can cover more than one bank (e.g., PREA closes all banks of a rank)
+        int scope = std::min<int>(m_dram->m_command_scopes(command), m_bank_addr_idx);
+        for_each_bank(addr_vec, scope, 1, 0, [this](int bank_id) {
+          if (m_bank_open_clk[bank_id] != -1) {
+            s_bank_busy_cycles[bank_id] += m_clk - m_bank_open_clk[bank_id];
+            m_bank_open_clk[bank_id] = -1;
+          }
+        });
+      }
+    };
+
+    /**
+     * @brief    Calls fn with the flat id of every bank that matches the address up to the scope level (-1 matches all)
+     * 
+     */
+    template<typename F>
+    void for_each_bank(const AddrVec_t& addr_vec, int scope, int level, int flat_id, F&& fn) const {
+      if (level > m_bank_addr_idx) {
+        fn(flat_id);
+        return;
+      }
+      int size = m_dram->m_organization.count[level];
+      if (level <= scope && addr_vec[level] >= 0) {
+        for_each_bank(addr_vec, scope, level + 1, flat_id * size + addr_vec[level], fn);
+      } else {
+        for (int child_id = 0; child_id < size; child_id++) {
+          for_each_bank(addr_vec, scope, level + 1, flat_id * size + child_id, fn);
+        }
+      }
+    };
+
+    /**
+     * @brief    Checks whether a request to the address is blocked by a request in the priority buffer before the given one
+     * @details
+     * A maintenance request blocks the nodes its final command works on: a whole rank (e.g., REFab), a bank (e.g.,
+     * VRR or REFsb in HBM), or the same bank in every bankgroup when the command is scoped between the rank and the
+     * bank (e.g., REFsb in DDR5). Requests to the other ranks and banks are served while it waits to be ready.
+     * 
+     */
+    bool is_blocked(const AddrVec_t& addr_vec, ReqBuffer::iterator until) {
+      for (auto it = m_priority_buffer.begin(); it != until; it++) {
+        int scope = m_dram->m_command_scopes(it->final_command);
+        bool is_same_bank = scope > m_rank_addr_idx && scope < m_bank_addr_idx;
+        int last_level = is_same_bank ? m_bank_addr_idx : std::min(scope, m_bank_addr_idx);
+
+        bool is_overlapping = true;
+        for (int level = 1; level <= last_level && is_overlapping; level++) {
+          if (is_same_bank && level > m_rank_addr_idx && level <= scope) {
+            continue;
+          }
+          // A negative address covers every node of the level
+          is_overlapping = it->addr_vec[level] < 0 || it->addr_vec[level] == addr_vec[level];
+        }
+        if (is_overlapping) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    void add_pending(Request&& req) {
+      pending.push_back({std::move(req), m_pending_seq++});
+      std::push_heap(pending.begin(), pending.end(), DepartsLater());
+    };
+
+    /**
+     * @brief    Helper function to serve the completed requests
+     * @details
+     * This function is called at the beginning of the tick() function.
+     * It pops every request that has finished by now (i.e., reads that have received their data from DRAM or have
+     * been forwarded, and writes that are acknowledged) off the pending heap, regardless of the order in which they
+     * were issued, and calls their callbacks.
+     */
+    void serve_completed_requests() {
+      while (pending.size() && pending.front().req.depart <= m_clk) {
+        std::pop_heap(pending.begin(), pending.end(), DepartsLater());
+        // Take the request out first, as its callback might send a new request to this controller
+        Request req = std::move(pending.back().req);
+        pending.pop_back();
+
+        if (req.callback) {
+          // If the request comes from outside (e.g., processor), call its callback
+          req.callback(req);
+        }
+      }
     };
 
 
@@ -172,17 +686,55 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
      * 
      */
     void set_write_mode() {
-      if (!m_is_write_mode) {
+      bool is_write_mode = m_is_write_mode;
+      if (m_write_drain) {
+        is_write_mode = m_write_drain->is_write_mode(m_is_write_mode, m_read_buffer, m_write_buffer);
+      } else if (!m_is_write_mode) {
         if ((m_write_buffer.size() > m_wr_high_watermark * m_write_buffer.max_size) || m_read_buffer.size() == 0) {
-          m_is_write_mode = true;
+          is_write_mode = true;
         }
       } else {
         if ((m_write_buffer.size() < m_wr_low_watermark * m_write_buffer.max_size) && m_read_buffer.size() != 0) {
-          m_is_write_mode = false;
+          is_write_mode = false;
+        }
+      }
+
+      if (is_write_mode != m_is_write_mode) {
+        m_is_write_mode = is_write_mode;
+        m_mode_switch_clk = m_clk;
+        if (is_write_mode) {
+          s_num_write_drains++;
         }
       }
     };
 
+    /**
+     * @brief    Counts the switches between read and write column commands and the data bus cycles they lose
+     * @details
+     * The lost cycles are the gap between the end of the last burst in the old direction and the start of the first
+     * burst in the new direction. The gap only counts from when the first burst could have started had the command
+     * been issued when the controller switched modes, so that idle time without requests is not counted.
+     * 
+     */
+    void update_turnaround_stats(int command) {
+      int direction = m_is_write_command[command] ? 1 : 0;
+      Clk_t latency = direction ? m_dram->m_write_latency : m_dram->m_read_latency;
+      Clk_t burst_start_clk = m_clk + latency - m_dram->m_burst_cycles;
+      if (m_last_column_direction != -1 && direction != m_last_column_direction) {
+        if (direction) {
+          s_num_read_to_write_turnarounds++;
+        } else {
+          s_num_write_to_read_turnarounds++;
+        }
+        Clk_t earliest_start_clk = std::max(m_last_burst_end_clk, m_mode_switch_clk + latency - m_dram->m_burst_cycles);
+        if (burst_start_clk > earliest_start_clk) {
+          s_turnaround_cycles += burst_start_clk - earliest_start_clk;
+        }
+      }
+      m_last_column_direction = direction;
+      m_last_burst_end_clk = std::max(m_last_burst_end_clk, burst_start_clk + m_dram->m_burst_cycles);
+    };
+
 
     /**
      * @brief    Helper function to find a request to schedule from the buffers.
@@ -191,7 +743,7 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
     bool schedule_request(ReqBuffer::iterator& req_it, ReqBuffer*& req_buffer) {
       bool request_found = false;
       // 2.1    First, check the act buffer to serve requests that are already activating (avoid useless ACTs)
-      if (req_it= m_scheduler->get_best_request(m_active_buffer); req_it != m_active_buffer.end()) {
+      if (req_it= m_scheduler->get_best_request(m_active_buffer, nullptr); req_it != m_active_buffer.end()) {
         if (m_dram->check_ready(req_it->command, req_it->addr_vec)) {
           request_found = true;
           req_buffer = &m_active_buffer;
@@ -200,15 +752,18 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
       // 2.2    If no requests can be scheduled from the act buffer, check the rest of the buffers
       if (!request_found) {
-        // 2.2.1    We first check the priority buffer to prioritize e.g., maintenance requests
-        if (m_priority_buffer.size() != 0) {
-          req_buffer = &m_priority_buffer;
-          req_it = m_priority_buffer.begin();
-          req_it->command = m_dram->get_preq_command(req_it->final_command, req_it->addr_vec);
-          
-          request_found = m_dram->check_ready(req_it->command, req_it->addr_vec);
-          if (!request_found & m_priority_buffer.size() != 0) {
-            return false;
+        // 2.2.1    We first check the priority buffer to prioritize e.g., maintenance requests. The requests to the same
+        //          ranks or banks are served in order, and the ones that are not ready only block these ranks or banks.
+        for (auto it = m_priority_buffer.begin(); it != m_priority_buffer.end(); it++) {
+          if (is_blocked(it->addr_vec, it)) {
+            continue;
+          }
+          it->command = m_dram->get_preq_command(it->final_command, it->addr_vec);
+          if (m_dram->check_ready(it->command, it->addr_vec)) {
+            request_found = true;
+            req_buffer = &m_priority_buffer;
+            req_it = it;
+            break;
           }
         }
 
@@ -217,7 +772,15 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
           // Query the write policy to decide which buffer to serve
           set_write_mode();
           auto& buffer = m_is_write_mode ? m_write_buffer : m_read_buffer;
-          if (req_it = m_scheduler->get_best_request(buffer); req_it != buffer.end()) {
+          std::function<bool(const Request&)> is_demand_blocked;
+          if (m_priority_buffer.size()) {
+            is_demand_blocked = [this](const Request& req) { return is_blocked(req.addr_vec, m_priority_buffer.end()); };
+          }
+          // The write drain policy may pick the write itself (e.g., to favour row hits)
+          if (m_is_write_mode && m_write_drain && m_write_drain->get_best_write(buffer, is_demand_blocked, req_it)) {
+            request_found = m_dram->check_ready(req_it->command, req_it->addr_vec);
+            req_buffer = &buffer;
+          } else if (req_it = m_scheduler->get_best_request(buffer, is_demand_blocked); req_it != buffer.end()) {
             request_found = m_dram->check_ready(req_it->command, req_it->addr_vec);
             req_buffer = &buffer;
           }
@@ -227,12 +790,9 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       // 2.3 If we find a request to schedule, we need to check if it will close an opened row in the active buffer.
       if (request_found) {
         if (m_dram->m_command_meta(req_it->command).is_closing) {
-          std::vector<Addr_t> rowgroup((req_it->addr_vec).begin(), (req_it->addr_vec).begin() + m_row_addr_idx);
-
           // Search the active buffer with the row address (inkl. banks, etc.)
           for (auto _it = m_active_buffer.begin(); _it != m_active_buffer.end(); _it++) {
-            std::vector<Addr_t> _it_rowgroup(_it->addr_vec.begin(), _it->addr_vec.begin() + m_row_addr_idx);
-            if (rowgroup == _it_rowgroup) {
+            if (req_it->addr_vec.same_prefix(_it->addr_vec, m_row_addr_idx)) {
               // Invalidate this scheduling outcome if we are to interrupt a request in the active buffer
               request_found = false;
             }
@@ -240,9 +800,18 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
         }
       }
 
+      // 2.4 Let the row policy decide whether the final command of the request also closes its row (e.g., RDA instead of RD)
+      if (request_found && m_row_policy && req_it->command == req_it->final_command) {
+        int auto_precharge_command = m_auto_precharge_commands[req_it->command];
+        if (auto_precharge_command != -1 && m_row_policy->should_close_row(*req_it) &&
+            !is_row_needed(req_it->addr_vec, req_it) && m_dram->check_ready(auto_precharge_command, req_it->addr_vec)) {
+          req_it->command = auto_precharge_command;
+        }
+      }
+
       return request_found;
     }
 
 };
   
-}   // namespace Ramulator
\ No newline at end of file
+}   // namespace Ramulator
\ No newline at end of file
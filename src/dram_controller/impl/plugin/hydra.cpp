@@ -368,10 +368,7 @@ class Hydra : public IControllerPlugin, public Implementation {
               }
               // generate write request to DRAM for rct
               for (int i = 0; i < m_group_rct_cl_size; i++){
-                std::vector<int> rct_init_addr_vec;
-                for (int j = 0; j < req_it->addr_vec.size(); j++){
-                  rct_init_addr_vec.push_back(req_it->addr_vec[j]);
-                }
+                AddrVec_t rct_init_addr_vec = req_it->addr_vec;
                 std::pair<Addr_t, Addr_t> init_row_col_id = generate_row_col_id(row_group_start_row_id + i * m_rct_per_cl);
                 rct_init_addr_vec[m_row_level] = init_row_col_id.first;
                 rct_init_addr_vec[m_col_level] = init_row_col_id.second;
@@ -415,10 +412,7 @@ class Hydra : public IControllerPlugin, public Implementation {
                   std::cout << "Hydra: RCC full, evicting " << tag_to_evict << std::endl;
                 }
                 // generate write request to DRAM for evicted entry
-                std::vector<int> evicted_entry_addr_vec;
-                for (int i = 0; i < req_it->addr_vec.size(); i++){
-                  evicted_entry_addr_vec.push_back(req_it->addr_vec[i]);
-                }
+                AddrVec_t evicted_entry_addr_vec = req_it->addr_vec;
                 int evicted_row_id = (tag_to_evict & ((1 << m_rcc_tag_row_bits) - 1)) << m_rcc_index_bits | rcc_index;
                 int evicted_bank_id = tag_to_evict >> m_rcc_tag_row_bits;
                 std::pair<Addr_t, Addr_t> evicted_row_col_id = generate_row_col_id(evicted_row_id);
@@ -88,7 +88,7 @@ class MSCache_Defense : public IControllerPlugin, public Implementation {
       m_num_rows_per_bank = m_dram->get_level_size("row");
 
       // Initialize flat bank ID to addr vec mapping
-      AddrVec_t addr_vec = std::vector<int>(m_dram->m_levels.size(), 0); 
+      AddrVec_t addr_vec(m_dram->m_levels.size(), 0);
       for (int rank = 0; rank < m_num_ranks; rank++) {
         addr_vec[m_rank_level] = rank;
         if (m_num_bankgroups == -1) {
@@ -363,10 +363,7 @@ class RRS : public IControllerPlugin, public Implementation {
 
     void issue_swap(ReqBuffer::iterator& req_it, int src_row, int dst_row) {
       // load addr_vec
-      std::vector<int> addr_vec;
-      for (int i = 0; i < req_it->addr_vec.size(); i++){
-        addr_vec.push_back(req_it->addr_vec[i]);
-      }
+      AddrVec_t addr_vec = req_it->addr_vec;
 
       // Read src_row to buffer0 
       addr_vec[m_row_level] = src_row;
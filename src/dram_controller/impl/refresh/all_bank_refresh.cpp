@@ -3,6 +3,7 @@
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/refresh.h"
+#include "dram_controller/impl/refresh/refresh_postponement.h"
 
 namespace Ramulator {
 
@@ -15,14 +16,32 @@ class AllBankRefresh : public IRefreshManager, public Implementation {
 
     int m_dram_org_levels = -1;
     int m_num_ranks = -1;
+    int m_rank_level = -1;
 
     int m_nrefi = -1;
     int m_ref_req_id = -1;
     Clk_t m_next_refresh_cycle = -1;
 
+    RefreshPostponement m_postponement;           // The configured postponement (copied to every rank)
+    std::vector<RefreshPostponement> m_ranks;
+
+    size_t s_num_refreshes = 0;
+    size_t s_num_postponed_refreshes = 0;
+    size_t s_num_pulled_in_refreshes = 0;
+
   public:
     void init() override { 
       m_ctrl = cast_parent<IDRAMController>();
+
+      m_postponement.max_postponed = param<int>("max_postponed").desc("Maximum number of refreshes that can be postponed while a rank is busy.").default_val(0);
+      m_postponement.max_pulled_in = param<int>("max_pulled_in").desc("Maximum number of refreshes that can be pulled in while a rank is idle.").default_val(0);
+      if (m_postponement.max_postponed < 0 || m_postponement.max_postponed > 8 || m_postponement.max_pulled_in < 0 || m_postponement.max_pulled_in > 8) {
+        throw ConfigurationError("JEDEC allows to postpone or pull in between 0 and 8 refreshes!");
+      }
+
+      register_stat(s_num_refreshes).name("num_refreshes");
+      register_stat(s_num_postponed_refreshes).name("num_postponed_refreshes");
+      register_stat(s_num_pulled_in_refreshes).name("num_pulled_in_refreshes");
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -30,6 +49,8 @@ class AllBankRefresh : public IRefreshManager, public Implementation {
 
       m_dram_org_levels = m_dram->m_levels.size();
       m_num_ranks = m_dram->get_level_size("rank");
+      m_rank_level = m_num_ranks > 0 ? m_dram->m_levels("rank") : -1;
+      m_ranks.resize(std::max(m_num_ranks, 0), m_postponement);
 
       m_nrefi = m_dram->m_timing_vals("nREFI");
       m_ref_req_id = m_dram->m_requests("all-bank-refresh");
@@ -41,19 +62,54 @@ class AllBankRefresh : public IRefreshManager, public Implementation {
       m_clk++;
 
       if (m_clk == m_next_refresh_cycle) {
+        // Follow the refresh interval of the current refresh mode (e.g., DDR4 fine granularity refresh)
+        m_nrefi = m_dram->m_timing_vals("nREFI");
         m_next_refresh_cycle += m_nrefi;
-        for (int r = 0; r < m_num_ranks; r++) {
-          std::vector<int> addr_vec(m_dram_org_levels, -1);
-          addr_vec[0] = m_ctrl->m_channel_id;
-          addr_vec[1] = r;
-          Request req(addr_vec, m_ref_req_id);
-
-          bool is_success = m_ctrl->priority_send(req);
-          if (!is_success) {
-            throw std::runtime_error("Failed to send refresh!");
+        for (auto& rank : m_ranks) {
+          if (rank.num_owed > 0) {
+            s_num_postponed_refreshes++;
           }
+          rank.add_owed();
         }
       }
+
+      for (int r = 0; r < m_num_ranks; r++) {
+        RefreshPostponement& rank = m_ranks[r];
+        if (!rank.is_pending()) {
+          continue;
+        }
+
+        AddrVec_t addr_vec(m_dram_org_levels, -1);
+        addr_vec[0] = m_ctrl->m_channel_id;
+        addr_vec[1] = r;
+        bool is_idle = m_ctrl->get_num_buffered_requests(addr_vec, m_rank_level) == 0;
+        if (!rank.should_refresh(is_idle)) {
+          continue;
+        }
+
+        Request req(addr_vec, m_ref_req_id);
+        // Retry at the next cycle if the refresh cannot be buffered
+        if (m_ctrl->priority_send(req)) {
+          if (rank.num_owed <= 0) {
+            s_num_pulled_in_refreshes++;
+          }
+          rank.on_refresh();
+          s_num_refreshes++;
+        }
+      }
+    };
+
+    Clk_t get_next_event_clk() override {
+      for (const auto& rank : m_ranks) {
+        if (rank.is_pending()) {
+          return m_clk + 1;
+        }
+      }
+      return m_next_refresh_cycle;
+    };
+
+    void fast_forward(Clk_t num_cycles) override {
+      m_clk += num_cycles;
     };
 
 };
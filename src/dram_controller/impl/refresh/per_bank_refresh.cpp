@@ -0,0 +1,252 @@
+#include <vector>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/refresh.h"
+#include "dram_controller/impl/refresh/refresh_postponement.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Refreshes the banks of every rank one refresh slot at a time
+ * @details
+ * A refresh slot is the set of banks covered by one per-bank or same-bank refresh command, which depends on the
+ * scope of the command in the standard:
+ *  - Bank scope (e.g., HBM REFsb): every bank of the rank is a slot.
+ *  - Between the rank and the bank (e.g., DDR5 REFsb at the bankgroup): the command refreshes the same bank in
+ *    every bankgroup, so the slots are the banks of one bankgroup.
+ *  - Rank scope (e.g., LPDDR5 REFpb): the command refreshes banks_per_refresh banks (e.g., a bank pair) per slot,
+ *    i.e., slot s refreshes the banks s, s + (number of slots), ... of the rank. The refresh is addressed to the
+ *    first bank, which the standard precharges as a prerequisite, and the other banks are precharged (with a
+ *    "precharge" request) before the refresh is sent.
+ * Every slot is refreshed once per nREFI, so a refresh is owed every nREFI / (number of slots) cycles.
+ * 
+ */
+class PerBankRefresh : public IRefreshManager, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IRefreshManager, PerBankRefresh, "PerBank", "Per-Bank (or Same-Bank) Refresh scheme.")
+  private:
+    Clk_t m_clk = 0;
+    IDRAM* m_dram;
+    IDRAMController* m_ctrl;
+
+    int m_dram_org_levels = -1;
+    int m_rank_level = -1;
+    int m_bank_level = -1;
+    int m_num_ranks = -1;
+
+    int m_ref_req_id = -1;
+    int m_ref_scope = -1;
+    int m_banks_per_refresh = -1;
+    int m_num_slots = -1;
+    int m_idle_level = -1;          // The level at which the demand on the refreshed banks is checked
+
+    int m_pre_req_id = -1;          // Closes the other banks of a rank-scoped slot
+    int m_open_check_cmd = -1;      // The command used to check whether a bank is open
+
+    Clk_t m_next_refresh_cycle = -1;
+
+    RefreshPostponement m_postponement;           // The configured postponement (copied to every rank)
+    std::vector<RefreshPostponement> m_ranks;
+    std::vector<int> m_next_slots;                // The next slot to refresh in every rank
+    std::vector<std::vector<bool>> m_is_precharging;  // Whether a precharge is sent to each other bank of the next slot
+
+    size_t s_num_refreshes = 0;
+    size_t s_num_postponed_refreshes = 0;
+    size_t s_num_pulled_in_refreshes = 0;
+    size_t s_num_refresh_precharges = 0;
+
+  public:
+    void init() override { 
+      m_ctrl = cast_parent<IDRAMController>();
+
+      m_banks_per_refresh = param<int>("banks_per_refresh").desc("Number of banks refreshed by a rank-scoped per-bank refresh (e.g., 2 for LPDDR5).").default_val(2);
+      m_postponement.max_postponed = param<int>("max_postponed").desc("Maximum number of refreshes that can be postponed while the banks are busy.").default_val(0);
+      m_postponement.max_pulled_in = param<int>("max_pulled_in").desc("Maximum number of refreshes that can be pulled in while the banks are idle.").default_val(0);
+      if (m_postponement.max_postponed < 0 || m_postponement.max_postponed > 8 || m_postponement.max_pulled_in < 0 || m_postponement.max_pulled_in > 8) {
+        throw ConfigurationError("JEDEC allows to postpone or pull in between 0 and 8 refreshes!");
+      }
+
+      register_stat(s_num_refreshes).name("num_refreshes");
+      register_stat(s_num_postponed_refreshes).name("num_postponed_refreshes");
+      register_stat(s_num_pulled_in_refreshes).name("num_pulled_in_refreshes");
+      register_stat(s_num_refresh_precharges).name("num_refresh_precharges");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_dram = m_ctrl->m_dram;
+      m_dram_org_levels = m_dram->m_levels.size();
+
+      for (auto req_name : {"per-bank-refresh", "same-bank-refresh"}) {
+        try {
+          m_ref_req_id = m_dram->m_requests(req_name);
+          break;
+        } catch (const std::out_of_range& e) {
+          continue;
+        }
+      }
+      if (m_ref_req_id == -1) {
+        throw ConfigurationError("The DRAM standard does not support per-bank or same-bank refresh!");
+      }
+      m_ref_scope = m_dram->m_command_scopes(m_dram->m_request_translations(m_ref_req_id));
+
+      // Standards without ranks (e.g., HBM) refresh the banks of every pseudochannel instead
+      m_rank_level = m_dram->get_level_size("rank") > 0 ? m_dram->m_levels("rank") : 1;
+      m_bank_level = m_dram->m_levels("bank");
+      m_num_ranks = m_dram->m_organization.count[m_rank_level];
+
+      if (m_ref_scope == m_rank_level) {
+        int num_banks = 1;
+        for (int level = m_rank_level + 1; level <= m_bank_level; level++) {
+          num_banks *= m_dram->m_organization.count[level];
+        }
+        m_num_slots = num_banks / m_banks_per_refresh;
+        m_idle_level = m_rank_level;
+
+        try {
+          m_pre_req_id = m_dram->m_requests("precharge");
+        } catch (const std::out_of_range& e) {
+          throw ConfigurationError("The DRAM standard cannot precharge the banks of a rank-scoped per-bank refresh!");
+        }
+        m_open_check_cmd = m_dram->m_request_translations(Request::Type::Read);
+      } else {
+        m_num_slots = 1;
+        for (int level = get_first_slot_level(); level <= m_bank_level; level++) {
+          m_num_slots *= m_dram->m_organization.count[level];
+        }
+        m_idle_level = m_ref_scope >= m_bank_level ? m_bank_level : m_rank_level;
+      }
+      if (m_num_slots <= 0) {
+        throw ConfigurationError("Invalid number of refresh slots ({}) per rank!", m_num_slots);
+      }
+
+      m_next_refresh_cycle = m_dram->m_timing_vals("nREFI") / m_num_slots;
+
+      m_ranks.resize(m_num_ranks, m_postponement);
+      m_next_slots.resize(m_num_ranks, 0);
+      m_is_precharging.resize(m_num_ranks, std::vector<bool>(m_banks_per_refresh, false));
+    };
+
+    void tick() {
+      m_clk++;
+
+      if (m_clk == m_next_refresh_cycle) {
+        // Follow the refresh interval of the current refresh mode
+        m_next_refresh_cycle += m_dram->m_timing_vals("nREFI") / m_num_slots;
+        for (auto& rank : m_ranks) {
+          if (rank.num_owed > 0) {
+            s_num_postponed_refreshes++;
+          }
+          rank.add_owed();
+        }
+      }
+
+      for (int r = 0; r < m_num_ranks; r++) {
+        RefreshPostponement& rank = m_ranks[r];
+        if (!rank.is_pending()) {
+          continue;
+        }
+
+        AddrVec_t addr_vec = get_slot_addr_vec(r, m_next_slots[r]);
+        bool is_idle = m_ctrl->get_num_buffered_requests(addr_vec, m_idle_level) == 0;
+        if (!rank.should_refresh(is_idle)) {
+          m_is_precharging[r].assign(m_banks_per_refresh, false);
+          continue;
+        }
+        // The refresh only covers some of the banks of the rank, so only these banks are closed (instead of the whole rank)
+        if (m_pre_req_id != -1 && !precharge_slot(r, m_next_slots[r])) {
+          continue;
+        }
+
+        Request req(addr_vec, m_ref_req_id);
+        // Retry at the next cycle if the refresh cannot be buffered
+        if (m_ctrl->priority_send(req)) {
+          if (rank.num_owed <= 0) {
+            s_num_pulled_in_refreshes++;
+          }
+          rank.on_refresh();
+          m_next_slots[r] = (m_next_slots[r] + 1) % m_num_slots;
+          m_is_precharging[r].assign(m_banks_per_refresh, false);
+          s_num_refreshes++;
+        }
+      }
+    };
+
+    Clk_t get_next_event_clk() override {
+      for (const auto& rank : m_ranks) {
+        if (rank.is_pending()) {
+          return m_clk + 1;
+        }
+      }
+      return m_next_refresh_cycle;
+    };
+
+    void fast_forward(Clk_t num_cycles) override {
+      m_clk += num_cycles;
+    };
+
+  private:
+    // The first level (below the rank) that tells the slots apart (the levels above it down to the scope are set to 0)
+    int get_first_slot_level() const {
+      return m_ref_scope >= m_bank_level ? m_rank_level + 1 : m_ref_scope + 1;
+    };
+
+    AddrVec_t get_slot_addr_vec(int rank_id, int slot_id) const {
+      AddrVec_t addr_vec(m_dram_org_levels, -1);
+      addr_vec[0] = m_ctrl->m_channel_id;
+      addr_vec[m_rank_level] = rank_id;
+      if (m_ref_scope == m_rank_level) {
+        return get_bank_addr_vec(rank_id, slot_id);
+      }
+
+      for (int level = m_rank_level + 1; level < get_first_slot_level(); level++) {
+        addr_vec[level] = 0;
+      }
+      for (int level = m_bank_level; level >= get_first_slot_level(); level--) {
+        addr_vec[level] = slot_id % m_dram->m_organization.count[level];
+        slot_id /= m_dram->m_organization.count[level];
+      }
+      return addr_vec;
+    };
+
+    /**
+     * @brief    Sends a precharge to the other open banks of a rank-scoped slot and returns whether all of them are closed
+     * @details
+     * The refresh is sent as soon as these banks are closed, after which it keeps the rank from opening them again.
+     * 
+     */
+    bool precharge_slot(int rank_id, int slot_id) {
+      bool is_closed = true;
+      for (int i = 1; i < m_banks_per_refresh; i++) {
+        AddrVec_t addr_vec = get_bank_addr_vec(rank_id, slot_id + i * m_num_slots);
+        if (!m_dram->check_node_open(m_open_check_cmd, addr_vec)) {
+          m_is_precharging[rank_id][i] = false;
+          continue;
+        }
+
+        is_closed = false;
+        if (!m_is_precharging[rank_id][i]) {
+          Request req(addr_vec, m_pre_req_id);
+          // Retry at the next cycle if the precharge cannot be buffered
+          if (m_ctrl->priority_send(req)) {
+            m_is_precharging[rank_id][i] = true;
+            s_num_refresh_precharges++;
+          }
+        }
+      }
+      return is_closed;
+    };
+
+    // The address of the bank with the given index (in the order of the address vector) in the rank
+    AddrVec_t get_bank_addr_vec(int rank_id, int bank_id) const {
+      AddrVec_t addr_vec(m_dram_org_levels, -1);
+      addr_vec[0] = m_ctrl->m_channel_id;
+      addr_vec[m_rank_level] = rank_id;
+      for (int level = m_bank_level; level > m_rank_level; level--) {
+        addr_vec[level] = bank_id % m_dram->m_organization.count[level];
+        bank_id /= m_dram->m_organization.count[level];
+      }
+      return addr_vec;
+    };
+};
+
+}       // namespace Ramulator
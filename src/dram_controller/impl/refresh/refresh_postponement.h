@@ -0,0 +1,46 @@
+#ifndef     RAMULATOR_CONTROLLER_REFRESH_POSTPONEMENT_H
+#define     RAMULATOR_CONTROLLER_REFRESH_POSTPONEMENT_H
+
+#include "base/base.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Keeps track of the refreshes owed by a rank to decide when to postpone or pull in a refresh
+ * @details
+ * JEDEC allows a number of refreshes (up to 8) to be postponed while the rank is busy and the same number to be
+ * pulled in (i.e., issued ahead of time) while it is idle. A refresh is owed at every refresh interval. An owed
+ * refresh is sent as soon as the rank is idle, and it cannot be postponed any further once the maximum number
+ * of refreshes are owed. With no postponement and no pull-in, every refresh is sent as soon as it is owed.
+ * 
+ */
+struct RefreshPostponement {
+  int max_postponed = 0;
+  int max_pulled_in = 0;
+  int num_owed = 0;     // Number of refreshes that are due but not sent yet (negative if refreshes were pulled in)
+
+  void add_owed() { num_owed++; };
+
+  /**
+   * @brief    Returns whether a refresh should be sent now given whether the rank has any demand request to serve
+   * 
+   */
+  bool should_refresh(bool is_idle) const {
+    if (num_owed > max_postponed) {
+      return true;
+    }
+    if (num_owed > 0) {
+      return is_idle;
+    }
+    return is_idle && -num_owed < max_pulled_in;
+  };
+
+  void on_refresh() { num_owed--; };
+
+  // Whether the decision of should_refresh() might change as the demand on the rank changes
+  bool is_pending() const { return num_owed > 0 || -num_owed < max_pulled_in; };
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_CONTROLLER_REFRESH_POSTPONEMENT_H
@@ -0,0 +1,159 @@
+#include <vector>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/row_policy.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Closes a row with a speculative PRE once it has not been accessed for a number of cycles
+ * 
+ */
+class TimeoutRowPolicy : public IRowPolicy, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IRowPolicy, TimeoutRowPolicy, "Timeout", "Closes rows that have not been accessed for a given number of cycles.")
+  private:
+    IDRAMController* m_ctrl;
+    IDRAM* m_dram;
+
+    Clk_t m_timeout = -1;
+
+    int m_bank_addr_idx = -1;
+    int m_read_command = -1;
+
+    struct BankState {
+      bool is_armed = false;        // Whether the bank might still have the row open since its last access
+      Clk_t last_access_clk = -1;
+      AddrVec_t addr_vec {};        // The address of the last access
+    };
+    std::vector<BankState> m_banks;
+
+    size_t s_num_idle_precharges = 0;
+
+  public:
+    void init() override {
+      m_timeout = param<int>("timeout").desc("Number of cycles without an access after which an open row is closed.").default_val(50);
+      register_stat(s_num_idle_precharges).name("num_idle_precharges");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_ctrl = cast_parent<IDRAMController>();
+      m_dram = m_ctrl->m_dram;
+      m_bank_addr_idx = m_dram->m_levels("bank");
+      m_read_command = m_dram->m_request_translations(Request::Type::Read);
+
+      int num_banks = m_dram->get_num_flat_ids(m_bank_addr_idx);
+      m_banks.resize(num_banks);
+    };
+
+    bool should_close_row(const Request& req) override {
+      return false;
+    };
+
+    void update(int command, const AddrVec_t& addr_vec) override {
+      const DRAMCommandMeta& meta = m_dram->m_command_meta(command);
+      if (meta.is_opening || meta.is_accessing) {
+        BankState& bank = m_banks[m_dram->get_flat_id(addr_vec, m_bank_addr_idx)];
+        bank.is_armed = true;
+        bank.last_access_clk = m_ctrl->get_clk();
+        bank.addr_vec = addr_vec;
+      }
+    };
+
+    bool get_idle_precharge(AddrVec_t& addr_vec, const std::function<bool(const AddrVec_t&)>& can_precharge) override {
+      Clk_t clk = m_ctrl->get_clk();
+      for (auto& bank : m_banks) {
+        if (!bank.is_armed || bank.last_access_clk + m_timeout > clk) {
+          continue;
+        }
+        // The row might have been closed by another command (e.g., PREA or RDA) in the meantime
+        if (!m_dram->check_rowbuffer_hit(m_read_command, bank.addr_vec)) {
+          bank.is_armed = false;
+          continue;
+        }
+        if (!can_precharge(bank.addr_vec)) {
+          continue;
+        }
+        addr_vec = bank.addr_vec;
+        bank.is_armed = false;
+        s_num_idle_precharges++;
+        return true;
+      }
+      return false;
+    };
+
+    Clk_t get_next_event_clk() override {
+      Clk_t next_clk = no_event_clk;
+      for (const auto& bank : m_banks) {
+        if (bank.is_armed) {
+          next_clk = std::min(next_clk, bank.last_access_clk + m_timeout);
+        }
+      }
+      return next_clk;
+    };
+};
+
+
+/**
+ * @brief    Predicts with a saturating counter per bank whether the next access to the bank hits the same row
+ * @details
+ * The counter of a bank is incremented when two consecutive accesses to the bank go to the same row and decremented
+ * otherwise. The final command of a request closes its row if the counter predicts that the next access will not hit it.
+ * 
+ */
+class PredictorRowPolicy : public IRowPolicy, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IRowPolicy, PredictorRowPolicy, "Predictor", "Closes rows that a per-bank saturating counter predicts will not be hit again.")
+  private:
+    IDRAM* m_dram;
+
+    int m_counter_max = -1;
+    int m_threshold = -1;
+
+    int m_bank_addr_idx = -1;
+    int m_row_addr_idx = -1;
+
+    std::vector<int> m_last_rows;     // The row of the last access to each bank (-1 if none)
+    std::vector<int> m_counters;
+
+  public:
+    void init() override {
+      int counter_bits = param<int>("counter_bits").desc("Number of bits of the per-bank saturating counters.").default_val(2);
+      m_counter_max = (1 << counter_bits) - 1;
+      m_threshold = 1 << (counter_bits - 1);
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_dram = cast_parent<IDRAMController>()->m_dram;
+      m_bank_addr_idx = m_dram->m_levels("bank");
+      m_row_addr_idx = m_dram->m_levels("row");
+
+      int num_banks = m_dram->get_num_flat_ids(m_bank_addr_idx);
+      m_last_rows.resize(num_banks, -1);
+      // Start out weakly predicting row hits (i.e., as an open-page policy)
+      m_counters.resize(num_banks, m_threshold);
+    };
+
+    bool should_close_row(const Request& req) override {
+      return m_counters[m_dram->get_flat_id(req.addr_vec, m_bank_addr_idx)] < m_threshold;
+    };
+
+    void update(int command, const AddrVec_t& addr_vec) override {
+      if (!m_dram->m_command_meta(command).is_accessing) {
+        return;
+      }
+
+      int bank_id = m_dram->get_flat_id(addr_vec, m_bank_addr_idx);
+      int row = addr_vec[m_row_addr_idx];
+      if (m_last_rows[bank_id] != -1) {
+        int& counter = m_counters[bank_id];
+        if (row == m_last_rows[bank_id]) {
+          counter = std::min(counter + 1, m_counter_max);
+        } else {
+          counter = std::max(counter - 1, 0);
+        }
+      }
+      m_last_rows[bank_id] = row;
+    };
+};
+
+}       // namespace Ramulator
@@ -0,0 +1,29 @@
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/row_policy.h"
+
+namespace Ramulator {
+
+class OpenPage : public IRowPolicy, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IRowPolicy, OpenPage, "OpenPage", "Open-page policy (rows stay open until a conflict).")
+
+  public:
+    void init() override { };
+
+    bool should_close_row(const Request& req) override {
+      return false;
+    };
+};
+
+class ClosedPage : public IRowPolicy, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IRowPolicy, ClosedPage, "ClosedPage", "Closed-page policy (rows are closed by RDA/WRA unless a buffered request hits them).")
+
+  public:
+    void init() override { };
+
+    bool should_close_row(const Request& req) override {
+      return true;
+    };
+};
+
+}       // namespace Ramulator
@@ -0,0 +1,148 @@
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/scheduler.h"
+#include "dram_controller/impl/scheduler/source_stats.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Adaptive per-Thread Least-Attained-Service scheduling (ATLAS, Kim et al., HPCA 2010)
+ * @details
+ * Every source accumulates the data bus time of the requests served for it. At the end of every quantum, the
+ * attained service of the quantum is folded into an exponentially weighted total, and the sources are ranked by
+ * it (least attained service first). Requests that waited longer than the starvation threshold go first, then
+ * the requests of the higher-ranked sources, then row hits, and finally the oldest requests.
+ * 
+ */
+class ATLAS : public IScheduler, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IScheduler, ATLAS, "ATLAS", "Adaptive per-Thread Least-Attained-Service (ATLAS) scheduling.")
+  private:
+    IDRAMController* m_ctrl;
+    IDRAM* m_dram;
+
+    Clk_t m_quantum = -1;
+    Clk_t m_next_quantum_clk = -1;
+    double m_alpha = 0.0;
+    Clk_t m_starvation_threshold = -1;
+
+    std::unordered_map<int, double> m_quantum_service;    // Attained service of each source in the current quantum
+    std::unordered_map<int, double> m_total_service;      // Weighted attained service of each source over the past quanta
+    std::unordered_map<int, int> m_ranks;                 // Rank of each source (0 is the highest)
+
+    size_t s_num_starved_requests = 0;
+    SourceServiceStats m_source_stats;
+
+  public:
+    void init() override {
+      m_quantum = param<Clk_t>("quantum").desc("Length of a ranking quantum in cycles.").default_val(100000);
+      m_alpha = param<double>("alpha").desc("Weight of the past attained service when a quantum ends.").default_val(0.875);
+      m_starvation_threshold = param<Clk_t>("starvation_threshold").desc("Requests older than this many cycles are prioritized over all others.").default_val(50000);
+      if (m_quantum <= 0) {
+        throw ConfigurationError("The quantum of ATLAS must be positive!");
+      }
+      m_next_quantum_clk = m_quantum;
+
+      register_stat(s_num_starved_requests).name("num_starved_requests");
+      m_source_stats.init(this);
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_ctrl = cast_parent<IDRAMController>();
+      m_dram = m_ctrl->m_dram;
+      m_source_stats.setup(m_ctrl);
+    };
+
+    ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+      bool starved1 = is_starved(*req1);
+      bool starved2 = is_starved(*req2);
+      if (starved1 ^ starved2) {
+        return starved1 ? req1 : req2;
+      }
+
+      int rank1 = get_rank(req1->source_id);
+      int rank2 = get_rank(req2->source_id);
+      if (rank1 != rank2) {
+        return rank1 < rank2 ? req1 : req2;
+      }
+
+      bool ready1 = m_dram->check_ready(req1->command, req1->addr_vec);
+      bool ready2 = m_dram->check_ready(req2->command, req2->addr_vec);
+      if (ready1 ^ ready2) {
+        return ready1 ? req1 : req2;
+      }
+
+      // Fallback to FCFS
+      return req1->arrive <= req2->arrive ? req1 : req2;
+    };
+
+    ReqBuffer::iterator get_best_request(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) override {
+      update_ranks();
+
+      auto candidate = buffer.end();
+      for (auto next = buffer.begin(); next != buffer.end(); next++) {
+        if (is_blocked && is_blocked(*next)) {
+          continue;
+        }
+        next->command = m_dram->get_preq_command(next->final_command, next->addr_vec);
+        candidate = candidate == buffer.end() ? next : compare(candidate, next);
+      }
+      return candidate;
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      m_source_stats.update(request_found, req_it);
+      if (request_found && req_it->source_id >= 0 && m_dram->m_command_meta(req_it->command).is_accessing) {
+        m_quantum_service[req_it->source_id] += m_dram->m_burst_cycles;
+        if (is_starved(*req_it)) {
+          s_num_starved_requests++;
+        }
+      }
+    };
+
+    void finalize() override {
+      m_source_stats.finalize();
+    };
+
+  private:
+    bool is_starved(const Request& req) const {
+      return req.arrive != -1 && m_ctrl->get_clk() - req.arrive > m_starvation_threshold;
+    };
+
+    int get_rank(int source_id) const {
+      auto it = m_ranks.find(source_id);
+      return it == m_ranks.end() ? m_ranks.size() : it->second;
+    };
+
+    // Ranks are only updated lazily (i.e., when the scheduler is asked for a request), as nothing is served in between
+    void update_ranks() {
+      if (m_ctrl->get_clk() < m_next_quantum_clk) {
+        return;
+      }
+      while (m_ctrl->get_clk() >= m_next_quantum_clk) {
+        for (auto& [source_id, total] : m_total_service) {
+          total *= m_alpha;
+        }
+        for (auto& [source_id, service] : m_quantum_service) {
+          m_total_service[source_id] += (1.0 - m_alpha) * service;
+          service = 0;
+        }
+        m_next_quantum_clk += m_quantum;
+      }
+
+      std::vector<std::pair<double, int>> order;
+      for (const auto& [source_id, total] : m_total_service) {
+        order.push_back({total, source_id});
+      }
+      std::sort(order.begin(), order.end());
+      m_ranks.clear();
+      for (int rank = 0; rank < order.size(); rank++) {
+        m_ranks[order[rank].second] = rank;
+      }
+    };
+};
+
+}       // namespace Ramulator
@@ -0,0 +1,164 @@
+#include <vector>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/scheduler.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    FR-FCFS that interleaves column commands (and activations) across bank groups
+ * @details
+ * Consecutive column commands to the same bank group are separated by nCCDL, while the ones to different bank
+ * groups only need nCCDS (and likewise nRRDL/nRRDS for activations). When several requests are ready, a column
+ * command to a different bank group than the last column command (or an activation to a different bank group than
+ * the last activation) is preferred, so that the next command to the skipped bank group only waits for the short
+ * timing. Otherwise, the requests are served as FR-FCFS (ready first, then oldest first).
+ * 
+ * Commands to another rank count as bank group switches.
+ * 
+ */
+class BankGroupFRFCFS : public IScheduler, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IScheduler, BankGroupFRFCFS, "BankGroupFRFCFS", "FRFCFS that interleaves commands across bank groups.")
+  private:
+    IDRAMController* m_ctrl;
+    IDRAM* m_dram;
+    int m_bankgroup_level = -1;
+
+    int m_last_column_bankgroup = -1;   // Flat bank group id of the last column command
+    int m_last_act_bankgroup = -1;      // Flat bank group id of the last activation
+
+    size_t s_num_column_commands = 0;
+    size_t s_num_bankgroup_switches = 0;
+    float s_bankgroup_switch_rate = 0;
+
+  public:
+    void init() override {
+      register_stat(s_num_column_commands).name("num_column_commands");
+      register_stat(s_num_bankgroup_switches).name("num_bankgroup_switches").desc("Column commands to a different bank group than the previous one");
+      register_stat(s_bankgroup_switch_rate).name("bankgroup_switch_rate");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_ctrl = cast_parent<IDRAMController>();
+      m_dram = m_ctrl->m_dram;
+      if (!m_dram->m_levels.contains("bankgroup")) {
+        throw ConfigurationError("BankGroupFRFCFS is not compatible with the DRAM implementation that does not have bank groups!");
+      }
+      m_bankgroup_level = m_dram->m_levels("bankgroup");
+    };
+
+    ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+      bool ready1 = m_dram->check_ready(req1->command, req1->addr_vec);
+      bool ready2 = m_dram->check_ready(req2->command, req2->addr_vec);
+      if (ready1 ^ ready2) {
+        return ready1 ? req1 : req2;
+      }
+
+      if (ready1) {
+        bool switch1 = is_bankgroup_switch(req1->command, req1->addr_vec);
+        bool switch2 = is_bankgroup_switch(req2->command, req2->addr_vec);
+        if (switch1 ^ switch2) {
+          return switch1 ? req1 : req2;
+        }
+      }
+
+      // Fallback to FCFS
+      return req1->arrive <= req2->arrive ? req1 : req2;
+    };
+
+    ReqBuffer::iterator get_best_request(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) override {
+      if (buffer.size() == 0) {
+        return buffer.end();
+      }
+
+      if (buffer.is_row_indexed()) {
+        return get_best_row_queue_head(buffer, is_blocked);
+      }
+
+      auto candidate = buffer.end();
+      for (auto next = buffer.begin(); next != buffer.end(); next++) {
+        if (is_blocked && is_blocked(*next)) {
+          continue;
+        }
+        next->command = m_dram->get_preq_command(next->final_command, next->addr_vec);
+        candidate = candidate == buffer.end() ? next : compare(candidate, next);
+      }
+      return candidate;
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      if (!request_found) {
+        return;
+      }
+
+      const DRAMCommandMeta& meta = m_dram->m_command_meta(req_it->command);
+      if (meta.is_accessing) {
+        int bankgroup_id = m_dram->get_flat_id(req_it->addr_vec, m_bankgroup_level);
+        s_num_column_commands++;
+        if (m_last_column_bankgroup != -1 && bankgroup_id != m_last_column_bankgroup) {
+          s_num_bankgroup_switches++;
+        }
+        m_last_column_bankgroup = bankgroup_id;
+      } else if (meta.is_opening) {
+        m_last_act_bankgroup = m_dram->get_flat_id(req_it->addr_vec, m_bankgroup_level);
+      }
+    };
+
+    void finalize() override {
+      if (s_num_column_commands > 1) {
+        s_bankgroup_switch_rate = (float) s_num_bankgroup_switches / (s_num_column_commands - 1);
+      }
+    };
+
+  private:
+    // Whether the command goes to a different bank group than the last command of the same kind
+    bool is_bankgroup_switch(int command, const AddrVec_t& addr_vec) const {
+      const DRAMCommandMeta& meta = m_dram->m_command_meta(command);
+      if (meta.is_accessing) {
+        return m_dram->get_flat_id(addr_vec, m_bankgroup_level) != m_last_column_bankgroup;
+      } else if (meta.is_opening) {
+        return m_dram->get_flat_id(addr_vec, m_bankgroup_level) != m_last_act_bankgroup;
+      }
+      return false;
+    };
+
+    /**
+     * @brief    Finds the same request as get_best_request() by only checking the oldest request of every row queue
+     * @details
+     * The requests of a row queue share their bank group, prerequisite command and readiness (cached in the same
+     * way as FRFCFS), so the best request is the oldest ready head that switches bank groups, then the oldest ready
+     * head, then the oldest head.
+     * 
+     */
+    ReqBuffer::iterator get_best_row_queue_head(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) {
+      auto candidate = buffer.end();
+      bool candidate_ready = false;
+      bool candidate_switch = false;
+      for (int queue_id : buffer.active_row_queues) {
+        auto& queue = buffer.row_queues[queue_id];
+        auto head = buffer.row_queue_head(queue_id);
+        // A blocked row is blocked for all of its requests
+        if (is_blocked && is_blocked(*head)) {
+          continue;
+        }
+
+        bool ready = m_ctrl->update_row_queue_command(buffer, queue_id);
+        head->command = queue.command;
+        bool is_switch = ready && is_bankgroup_switch(queue.command, head->addr_vec);
+
+        if (candidate == buffer.end() || (ready && !candidate_ready) || (is_switch && !candidate_switch)) {
+          candidate = head;
+          candidate_ready = ready;
+          candidate_switch = is_switch;
+        } else if (ready == candidate_ready && is_switch == candidate_switch) {
+          if (head->arrive < candidate->arrive || (head->arrive == candidate->arrive && head.seq() < candidate.seq())) {
+            candidate = head;
+          }
+        }
+      }
+      return candidate;
+    };
+};
+
+}       // namespace Ramulator
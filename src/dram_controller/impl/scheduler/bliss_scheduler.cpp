@@ -0,0 +1,113 @@
+#include <unordered_set>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/scheduler.h"
+#include "dram_controller/impl/scheduler/source_stats.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Blacklisting memory scheduler (BLISS, Subramanian et al., ICCD 2014)
+ * @details
+ * A source that gets blacklist_threshold requests served back to back is blacklisted, and the blacklist is cleared
+ * every clearing_interval cycles. Requests of the sources that are not blacklisted go first, then row hits, and
+ * finally the oldest requests.
+ * 
+ */
+class BLISS : public IScheduler, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IScheduler, BLISS, "BLISS", "Blacklisting memory scheduler (BLISS).")
+  private:
+    IDRAMController* m_ctrl;
+    IDRAM* m_dram;
+
+    int m_blacklist_threshold = -1;
+    Clk_t m_clearing_interval = -1;
+    Clk_t m_next_clearing_clk = -1;
+
+    int m_last_source_id = -1;
+    int m_num_consecutive_reqs = 0;     // Number of requests of the last source served back to back
+    std::unordered_set<int> m_blacklist;
+
+    size_t s_num_blacklistings = 0;
+    SourceServiceStats m_source_stats;
+
+  public:
+    void init() override {
+      m_blacklist_threshold = param<int>("blacklist_threshold").desc("Number of consecutive requests served to a source before it is blacklisted.").default_val(4);
+      m_clearing_interval = param<Clk_t>("clearing_interval").desc("Number of cycles between clearing the blacklist.").default_val(10000);
+      if (m_blacklist_threshold <= 0 || m_clearing_interval <= 0) {
+        throw ConfigurationError("The blacklisting threshold and clearing interval of BLISS must be positive!");
+      }
+      m_next_clearing_clk = m_clearing_interval;
+
+      register_stat(s_num_blacklistings).name("num_blacklistings");
+      m_source_stats.init(this);
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_ctrl = cast_parent<IDRAMController>();
+      m_dram = m_ctrl->m_dram;
+      m_source_stats.setup(m_ctrl);
+    };
+
+    ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+      bool blacklisted1 = m_blacklist.count(req1->source_id);
+      bool blacklisted2 = m_blacklist.count(req2->source_id);
+      if (blacklisted1 ^ blacklisted2) {
+        return blacklisted1 ? req2 : req1;
+      }
+
+      bool ready1 = m_dram->check_ready(req1->command, req1->addr_vec);
+      bool ready2 = m_dram->check_ready(req2->command, req2->addr_vec);
+      if (ready1 ^ ready2) {
+        return ready1 ? req1 : req2;
+      }
+
+      // Fallback to FCFS
+      return req1->arrive <= req2->arrive ? req1 : req2;
+    };
+
+    ReqBuffer::iterator get_best_request(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) override {
+      // The blacklist is only cleared lazily (i.e., when the scheduler is asked for a request)
+      if (m_ctrl->get_clk() >= m_next_clearing_clk) {
+        m_blacklist.clear();
+        while (m_ctrl->get_clk() >= m_next_clearing_clk) {
+          m_next_clearing_clk += m_clearing_interval;
+        }
+      }
+
+      auto candidate = buffer.end();
+      for (auto next = buffer.begin(); next != buffer.end(); next++) {
+        if (is_blocked && is_blocked(*next)) {
+          continue;
+        }
+        next->command = m_dram->get_preq_command(next->final_command, next->addr_vec);
+        candidate = candidate == buffer.end() ? next : compare(candidate, next);
+      }
+      return candidate;
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      m_source_stats.update(request_found, req_it);
+      if (!request_found || req_it->source_id < 0 || !m_dram->m_command_meta(req_it->command).is_accessing) {
+        return;
+      }
+
+      if (req_it->source_id == m_last_source_id) {
+        m_num_consecutive_reqs++;
+      } else {
+        m_last_source_id = req_it->source_id;
+        m_num_consecutive_reqs = 1;
+      }
+      if (m_num_consecutive_reqs >= m_blacklist_threshold && m_blacklist.insert(req_it->source_id).second) {
+        s_num_blacklistings++;
+      }
+    };
+
+    void finalize() override {
+      m_source_stats.finalize();
+    };
+};
+
+}       // namespace Ramulator
@@ -0,0 +1,154 @@
+#include <vector>
+#include <algorithm>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/scheduler.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    FR-FCFS with a cap on consecutive row hits per bank and an age threshold
+ * @details
+ * Once max_row_hits column commands are served to the open row of a bank back to back, the requests that hit
+ * this row lose their priority as ready requests while a request to another row of the bank waits (until the
+ * bank activates another row), so the latter is no longer starved by a stream of row hits. Requests that waited longer than
+ * age_threshold cycles are prioritized over all others (oldest first).
+ * 
+ */
+class CappedFRFCFS : public IScheduler, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IScheduler, CappedFRFCFS, "CappedFRFCFS", "FRFCFS with a row-hit streak cap and a starvation guard.")
+  private:
+    IDRAMController* m_ctrl;
+    IDRAM* m_dram;
+    int m_bank_level = -1;
+
+    int m_max_row_hits = -1;
+    Clk_t m_age_threshold = -1;
+    std::vector<int> m_row_hit_streaks;   // Number of column commands served to the open row of each bank back to back
+    std::vector<bool> m_has_waiting_miss; // Whether a request that does not hit the open row waits for the bank (per scheduling decision)
+    std::vector<ReqBuffer::iterator> m_candidates;
+
+    size_t s_num_capped_streaks = 0;
+    size_t s_num_starvation_events = 0;
+    Clk_t s_max_queueing_delay = 0;
+
+  public:
+    void init() override {
+      m_max_row_hits = param<int>("max_row_hits").desc("Maximum number of consecutive row hits served to a bank while other requests wait.").default_val(16);
+      m_age_threshold = param<Clk_t>("age_threshold").desc("Requests older than this many cycles are prioritized over all others.").default_val(5000);
+      if (m_max_row_hits <= 0 || m_age_threshold <= 0) {
+        throw ConfigurationError("The row hit cap and the age threshold of CappedFRFCFS must be positive!");
+      }
+
+      register_stat(s_num_capped_streaks).name("num_capped_streaks");
+      register_stat(s_num_starvation_events).name("num_starvation_events").desc("Requests served after waiting longer than the age threshold");
+      register_stat(s_max_queueing_delay).name("max_queueing_delay");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_ctrl = cast_parent<IDRAMController>();
+      m_dram = m_ctrl->m_dram;
+      m_bank_level = m_dram->m_levels("bank");
+
+      int num_banks = m_dram->get_num_flat_ids(m_bank_level);
+      m_row_hit_streaks.resize(num_banks, 0);
+      m_has_waiting_miss.resize(num_banks, false);
+    };
+
+    ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+      bool starved1 = is_starved(*req1);
+      bool starved2 = is_starved(*req2);
+      if (starved1 ^ starved2) {
+        return starved1 ? req1 : req2;
+      }
+
+      if (!starved1) {
+        bool ready1 = is_prioritized_ready(*req1);
+        bool ready2 = is_prioritized_ready(*req2);
+        if (ready1 ^ ready2) {
+          return ready1 ? req1 : req2;
+        }
+      }
+
+      // Fallback to FCFS
+      return req1->arrive <= req2->arrive ? req1 : req2;
+    };
+
+    ReqBuffer::iterator get_best_request(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) override {
+      m_candidates.clear();
+      auto consider = [&](ReqBuffer::iterator next) {
+        if (is_blocked && is_blocked(*next)) {
+          return;
+        }
+        next->command = m_dram->get_preq_command(next->final_command, next->addr_vec);
+        m_candidates.push_back(next);
+      };
+
+      if (buffer.is_row_indexed()) {
+        // The requests of a row queue share their bank and readiness, so the oldest one (the head) is the best of them
+        for (int queue_id : buffer.active_row_queues) {
+          consider(buffer.row_queue_head(queue_id));
+        }
+      } else {
+        for (auto next = buffer.begin(); next != buffer.end(); next++) {
+          consider(next);
+        }
+      }
+
+      for (auto req_it : m_candidates) {
+        if (!m_dram->m_command_meta(req_it->command).is_accessing) {
+          m_has_waiting_miss[m_dram->get_flat_id(req_it->addr_vec, m_bank_level)] = true;
+        }
+      }
+      auto candidate = buffer.end();
+      for (auto req_it : m_candidates) {
+        candidate = candidate == buffer.end() ? req_it : compare(candidate, req_it);
+      }
+      for (auto req_it : m_candidates) {
+        m_has_waiting_miss[m_dram->get_flat_id(req_it->addr_vec, m_bank_level)] = false;
+      }
+      return candidate;
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      if (!request_found) {
+        return;
+      }
+
+      if (req_it->arrive != -1 && req_it->issue == -1) {
+        s_max_queueing_delay = std::max(s_max_queueing_delay, m_ctrl->get_clk() - req_it->arrive);
+      }
+
+      const DRAMCommandMeta& meta = m_dram->m_command_meta(req_it->command);
+      if (meta.is_opening) {
+        m_row_hit_streaks[m_dram->get_flat_id(req_it->addr_vec, m_bank_level)] = 0;
+      } else if (meta.is_accessing) {
+        if (++m_row_hit_streaks[m_dram->get_flat_id(req_it->addr_vec, m_bank_level)] == m_max_row_hits) {
+          s_num_capped_streaks++;
+        }
+        if (is_starved(*req_it)) {
+          s_num_starvation_events++;
+        }
+      }
+    };
+
+  private:
+    bool is_starved(const Request& req) const {
+      return req.arrive != -1 && m_ctrl->get_clk() - req.arrive > m_age_threshold;
+    };
+
+    // A ready row hit to a bank that has reached the cap is not prioritized while a request to another row waits
+    bool is_prioritized_ready(const Request& req) const {
+      if (!m_dram->check_ready(req.command, req.addr_vec)) {
+        return false;
+      }
+      if (!m_dram->m_command_meta(req.command).is_accessing) {
+        return true;
+      }
+      int bank_id = m_dram->get_flat_id(req.addr_vec, m_bank_level);
+      return m_row_hit_streaks[bank_id] < m_max_row_hits || !m_has_waiting_miss[bank_id];
+    };
+};
+
+}       // namespace Ramulator
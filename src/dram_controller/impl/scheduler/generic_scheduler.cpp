@@ -9,13 +9,19 @@ namespace Ramulator {
 class FRFCFS : public IScheduler, public Implementation {
   RAMULATOR_REGISTER_IMPLEMENTATION(IScheduler, FRFCFS, "FRFCFS", "FRFCFS DRAM Scheduler.")
   private:
+    IDRAMController* m_ctrl;
     IDRAM* m_dram;
 
+    bool m_check_row_cache = false;
+
   public:
-    void init() override { };
+    void init() override {
+      m_check_row_cache = param<bool>("check_row_cache").desc("Checks every request picked with the cached row queue commands against a full scan of the buffer (slow, for debugging).").default_val(false);
+    };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
-      m_dram = cast_parent<IDRAMController>()->m_dram;
+      m_ctrl = cast_parent<IDRAMController>();
+      m_dram = m_ctrl->m_dram;
     };
 
     ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
@@ -38,18 +44,80 @@ class FRFCFS : public IScheduler, public Implementation {
       } 
     }
 
-    ReqBuffer::iterator get_best_request(ReqBuffer& buffer) override {
+    ReqBuffer::iterator get_best_request(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) override {
       if (buffer.size() == 0) {
         return buffer.end();
       }
 
-      for (auto& req : buffer) {
-        req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
+      if (buffer.is_row_indexed()) {
+        auto candidate = get_best_row_queue_head(buffer, is_blocked);
+        if (m_check_row_cache) {
+          check_row_cache(buffer, is_blocked, candidate);
+        }
+        return candidate;
+      }
+
+      return get_best_scanned_request(buffer, is_blocked);
+    }
+
+  private:
+    ReqBuffer::iterator get_best_scanned_request(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) {
+      auto candidate = buffer.end();
+      for (auto next = buffer.begin(); next != buffer.end(); next++) {
+        if (is_blocked && is_blocked(*next)) {
+          continue;
+        }
+        next->command = m_dram->get_preq_command(next->final_command, next->addr_vec);
+        candidate = candidate == buffer.end() ? next : compare(candidate, next);
+      }
+      return candidate;
+    }
+
+    /**
+     * @brief    Checks that a full scan of the buffer (without any cached command) picks the same request and command
+     * 
+     */
+    void check_row_cache(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked, ReqBuffer::iterator candidate) {
+      int cached_command = candidate == buffer.end() ? -1 : candidate->command;
+      auto expected = get_best_scanned_request(buffer, is_blocked);
+      if (expected != candidate || (candidate != buffer.end() && candidate->command != cached_command)) {
+        throw std::runtime_error(fmt::format("[FRFCFS] The cached row queue commands picked a different request than a full scan at cycle {}!", m_ctrl->get_clk()));
       }
+    }
 
-      auto candidate = buffer.begin();
-      for (auto next = std::next(buffer.begin(), 1); next != buffer.end(); next++) {
-        candidate = compare(candidate, next);
+    /**
+     * @brief    Finds the same request as get_best_request() by only checking the oldest request of every row queue
+     * @details
+     * The requests of a row queue have the same prerequisite command and readiness, and the oldest one
+     * arrives first and is the earliest in the buffer. Therefore, the best request is the oldest ready head
+     * (or the oldest head if none is ready), with ties on arrival broken by the order in the buffer.
+     * 
+     * The prerequisite command of a row is cached in its row queue by the controller (see
+     * IDRAMController::update_row_queue_command()).
+     * 
+     */
+    ReqBuffer::iterator get_best_row_queue_head(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) {
+      auto candidate = buffer.end();
+      bool candidate_ready = false;
+      for (int queue_id : buffer.active_row_queues) {
+        auto& queue = buffer.row_queues[queue_id];
+        auto head = buffer.row_queue_head(queue_id);
+        // A blocked row is blocked for all of its requests
+        if (is_blocked && is_blocked(*head)) {
+          continue;
+        }
+
+        bool ready = m_ctrl->update_row_queue_command(buffer, queue_id);
+        head->command = queue.command;
+
+        if (candidate == buffer.end() || (ready && !candidate_ready)) {
+          candidate = head;
+          candidate_ready = ready;
+        } else if (ready == candidate_ready) {
+          if (head->arrive < candidate->arrive || (head->arrive == candidate->arrive && head.seq() < candidate.seq())) {
+            candidate = head;
+          }
+        }
       }
       return candidate;
     }
@@ -0,0 +1,164 @@
+#include <vector>
+#include <set>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <algorithm>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/scheduler.h"
+#include "dram_controller/impl/scheduler/source_stats.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Parallelism-Aware Batch Scheduling (PAR-BS, Mutlu and Moscibroda, ISCA 2008)
+ * @details
+ * Once the current batch is served, the oldest batch_cap requests of every source to every bank in the read or
+ * write buffer form the next batch. Batched requests are always prioritized over the others, so no source can be
+ * starved for longer than a batch. Within the batch, the sources are ranked shortest job first: the ones with the
+ * fewest batched requests to any single bank (and then the fewest in total) go first, which serves the requests
+ * of a source in parallel across the banks. Then, row hits go first and finally the oldest requests.
+ * 
+ */
+class PARBS : public IScheduler, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IScheduler, PARBS, "PARBS", "Parallelism-Aware Batch Scheduling (PAR-BS).")
+  private:
+    IDRAMController* m_ctrl;
+    IDRAM* m_dram;
+    int m_bank_level = -1;
+    int m_batch_cap = -1;
+
+    using BatchKey_t = std::tuple<int, Clk_t, Addr_t>;   // (source, arrive, addr) identifies a request across buffers
+    std::multiset<BatchKey_t> m_batch;                   // The requests of the current batch that are not served yet
+    std::unordered_map<int, int> m_ranks;                // Rank of each source in the current batch (0 is the highest)
+
+    size_t s_num_batches = 0;
+    SourceServiceStats m_source_stats;
+
+  public:
+    void init() override {
+      m_batch_cap = param<int>("batch_cap").desc("Maximum number of requests of a source to a bank in a batch.").default_val(5);
+      if (m_batch_cap <= 0) {
+        throw ConfigurationError("The batch cap of PAR-BS must be positive!");
+      }
+
+      register_stat(s_num_batches).name("num_batches");
+      m_source_stats.init(this);
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_ctrl = cast_parent<IDRAMController>();
+      m_dram = m_ctrl->m_dram;
+      m_bank_level = m_dram->m_levels("bank");
+      m_source_stats.setup(m_ctrl);
+    };
+
+    ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+      bool batched1 = is_batched(*req1);
+      bool batched2 = is_batched(*req2);
+      if (batched1 ^ batched2) {
+        return batched1 ? req1 : req2;
+      }
+
+      bool ready1 = m_dram->check_ready(req1->command, req1->addr_vec);
+      bool ready2 = m_dram->check_ready(req2->command, req2->addr_vec);
+      if (ready1 ^ ready2) {
+        return ready1 ? req1 : req2;
+      }
+
+      int rank1 = get_rank(req1->source_id);
+      int rank2 = get_rank(req2->source_id);
+      if (rank1 != rank2) {
+        return rank1 < rank2 ? req1 : req2;
+      }
+
+      // Fallback to FCFS
+      return req1->arrive <= req2->arrive ? req1 : req2;
+    };
+
+    ReqBuffer::iterator get_best_request(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) override {
+      // The active buffer only holds requests that are already being served, so batches are formed from the
+      // (row-indexed) read and write buffers
+      if (m_batch.empty() && buffer.is_row_indexed() && buffer.size()) {
+        form_batch(buffer);
+      }
+
+      auto candidate = buffer.end();
+      for (auto next = buffer.begin(); next != buffer.end(); next++) {
+        if (is_blocked && is_blocked(*next)) {
+          continue;
+        }
+        next->command = m_dram->get_preq_command(next->final_command, next->addr_vec);
+        candidate = candidate == buffer.end() ? next : compare(candidate, next);
+      }
+      return candidate;
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      m_source_stats.update(request_found, req_it);
+      if (request_found && m_dram->m_command_meta(req_it->command).is_accessing) {
+        if (auto it = m_batch.find(get_batch_key(*req_it)); it != m_batch.end()) {
+          m_batch.erase(it);
+        }
+      }
+    };
+
+    void finalize() override {
+      m_source_stats.finalize();
+    };
+
+  private:
+    BatchKey_t get_batch_key(const Request& req) const {
+      return {req.source_id, req.arrive, req.addr};
+    };
+
+    bool is_batched(const Request& req) const {
+      return m_batch.size() && m_batch.count(get_batch_key(req));
+    };
+
+    int get_rank(int source_id) const {
+      auto it = m_ranks.find(source_id);
+      return it == m_ranks.end() ? m_ranks.size() : it->second;
+    };
+
+    void form_batch(ReqBuffer& buffer) {
+      // The buffer keeps the requests in arrival order, so the first batch_cap requests of a source to a bank are its oldest
+      std::map<std::pair<int, int>, int> num_batched_per_bank;    // (source, bank) -> number of batched requests
+      for (const auto& req : buffer) {
+        if (req.type_id != Request::Type::Read && req.type_id != Request::Type::Write) {
+          continue;
+        }
+        int& num_batched = num_batched_per_bank[{req.source_id, m_dram->get_flat_id(req.addr_vec, m_bank_level)}];
+        if (num_batched < m_batch_cap) {
+          num_batched++;
+          m_batch.insert(get_batch_key(req));
+        }
+      }
+      if (m_batch.empty()) {
+        return;
+      }
+      s_num_batches++;
+
+      // Shortest job first: rank the sources by their maximum load on a bank, then by their total load
+      std::map<int, std::pair<int, int>> loads;   // source -> (max bank load, total load)
+      for (const auto& [key, num_batched] : num_batched_per_bank) {
+        auto& load = loads[key.first];
+        load.first = std::max(load.first, num_batched);
+        load.second += num_batched;
+      }
+      std::vector<std::pair<std::pair<int, int>, int>> order;
+      for (const auto& [source_id, load] : loads) {
+        order.push_back({load, source_id});
+      }
+      std::sort(order.begin(), order.end());
+
+      m_ranks.clear();
+      for (int rank = 0; rank < order.size(); rank++) {
+        m_ranks[order[rank].second] = rank;
+      }
+    };
+};
+
+}       // namespace Ramulator
@@ -0,0 +1,214 @@
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/scheduler.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Scheduler that serves the QoS classes of the requests (Request::qos_class) by strict priority or weighted shares
+ * @details
+ * With the strict policy, a request of a higher class is always preferred over a request of a lower class. With the
+ * weighted policy, every class is given a share of the served accesses proportional to its weight: each class keeps a
+ * virtual finish time that advances by 1/weight whenever one of its requests is served, and the class with the
+ * earliest virtual time is preferred. A class that becomes backlogged again starts from the current system virtual
+ * time, so it does not bank the bandwidth it did not use while idle (i.e., start-time fair queuing).
+ * 
+ * The scheduler is work-conserving: ready requests are always preferred over requests that are not ready, the class
+ * only decides between requests of the same readiness, and FCFS breaks the remaining ties. Within a row queue
+ * (whose requests share their readiness), the request of the best class is served first.
+ * 
+ */
+class QoS : public IScheduler, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IScheduler, QoS, "QoS", "Strict priority or weighted share scheduler between QoS classes.")
+  private:
+    IDRAMController* m_ctrl;
+    IDRAM* m_dram;
+    int m_access_bytes = -1;
+
+    bool m_is_weighted = false;
+    std::vector<int> m_weights;             // The weight of each class (classes without an entry have a weight of 1)
+    std::vector<double> m_virtual_times;    // The virtual finish time of each class
+    double m_system_virtual_time = 0.0;     // The virtual start time of the last served request
+
+    std::map<int, size_t> m_total_latency;
+
+    std::map<int, size_t> s_num_served_requests;
+    std::map<int, float> s_bandwidth;
+    std::map<int, float> s_avg_latency;
+    std::map<int, Clk_t> s_max_latency;
+
+  public:
+    void init() override {
+      std::string policy = param<std::string>("policy").desc("How to arbitrate between QoS classes (strict or weighted).").default_val("strict");
+      if (policy == "strict") {
+        m_is_weighted = false;
+      } else if (policy == "weighted") {
+        m_is_weighted = true;
+      } else {
+        throw ConfigurationError("Unknown QoS policy \"{}\" (expected strict or weighted)!", policy);
+      }
+
+      m_weights = param<std::vector<int>>("weights").desc("The weight of each QoS class with the weighted policy (indexed by class).").default_val(std::vector<int>());
+      for (int weight : m_weights) {
+        if (weight <= 0) {
+          throw ConfigurationError("The weights of the QoS classes must be positive!");
+        }
+      }
+      m_virtual_times.resize(m_weights.size(), 0.0);
+
+      register_stat(s_num_served_requests).name("num_served_requests_per_class");
+      register_stat(s_bandwidth).name("bandwidth_per_class").desc("GB/s");
+      register_stat(s_avg_latency).name("avg_latency_per_class").desc("Memory cycles from arriving at the controller to departing");
+      register_stat(s_max_latency).name("max_latency_per_class");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_ctrl = cast_parent<IDRAMController>();
+      m_dram = m_ctrl->m_dram;
+      m_access_bytes = m_dram->m_internal_prefetch_size * m_dram->m_channel_width / 8;
+    };
+
+    ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+      bool ready1 = m_dram->check_ready(req1->command, req1->addr_vec);
+      bool ready2 = m_dram->check_ready(req2->command, req2->addr_vec);
+      if (ready1 ^ ready2) {
+        return ready1 ? req1 : req2;
+      }
+
+      double rank1 = get_class_rank(req1->qos_class);
+      double rank2 = get_class_rank(req2->qos_class);
+      if (rank1 != rank2) {
+        return rank1 < rank2 ? req1 : req2;
+      }
+
+      // Fallback to FCFS
+      return req1->arrive <= req2->arrive ? req1 : req2;
+    };
+
+    ReqBuffer::iterator get_best_request(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) override {
+      if (buffer.size() == 0) {
+        return buffer.end();
+      }
+
+      if (buffer.is_row_indexed()) {
+        return get_best_row_queue_request(buffer, is_blocked);
+      }
+
+      auto candidate = buffer.end();
+      for (auto next = buffer.begin(); next != buffer.end(); next++) {
+        if (is_blocked && is_blocked(*next)) {
+          continue;
+        }
+        next->command = m_dram->get_preq_command(next->final_command, next->addr_vec);
+        candidate = candidate == buffer.end() ? next : compare(candidate, next);
+      }
+      return candidate;
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      if (!request_found || !m_dram->m_command_meta(req_it->command).is_accessing || req_it->arrive == -1) {
+        return;
+      }
+      bool is_read = req_it->type_id == Request::Type::Read;
+      if (!is_read && req_it->type_id != Request::Type::Write) {
+        return;
+      }
+
+      int qos_class = req_it->qos_class;
+      Clk_t latency = m_ctrl->get_clk() + (is_read ? m_dram->m_read_latency : m_dram->m_write_latency) - req_it->arrive;
+      s_num_served_requests[qos_class]++;
+      m_total_latency[qos_class] += latency;
+      s_max_latency[qos_class] = std::max(s_max_latency[qos_class], latency);
+
+      if (m_is_weighted) {
+        int class_id = get_class_id(qos_class);
+        double start = std::max(m_virtual_times[class_id], m_system_virtual_time);
+        m_system_virtual_time = start;
+        m_virtual_times[class_id] = start + 1.0 / (class_id < m_weights.size() ? m_weights[class_id] : 1);
+      }
+    };
+
+    void finalize() override {
+      Clk_t clk = m_ctrl->get_clk();
+      int tCK_ps = m_dram->m_timing_vals("tCK_ps");
+      for (const auto& [qos_class, num_reqs] : s_num_served_requests) {
+        if (clk > 0) {
+          // Bytes per picosecond * 1000 = GB/s
+          s_bandwidth[qos_class] = 1000.0f * num_reqs * m_access_bytes / (clk * tCK_ps);
+        }
+        s_avg_latency[qos_class] = (float) m_total_latency[qos_class] / num_reqs;
+      }
+    };
+
+  private:
+    // Classes below 0 are served as class 0
+    int get_class_id(int qos_class) {
+      int class_id = std::max(qos_class, 0);
+      if (class_id >= m_virtual_times.size()) {
+        m_virtual_times.resize(class_id + 1, 0.0);
+      }
+      return class_id;
+    };
+
+    // The lower the rank, the higher the priority of the class
+    double get_class_rank(int qos_class) {
+      if (!m_is_weighted) {
+        return -qos_class;
+      }
+      return std::max(m_virtual_times[get_class_id(qos_class)], m_system_virtual_time);
+    };
+
+    /**
+     * @brief    Finds the best request by checking the readiness of every row queue once
+     * @details
+     * The requests of a row queue share their prerequisite command and readiness, so the readiness is checked
+     * with the oldest request (cached in the same way as FRFCFS) and the request of the best class in the queue
+     * (the oldest one on ties) stands for the queue.
+     * 
+     */
+    ReqBuffer::iterator get_best_row_queue_request(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) {
+      auto candidate = buffer.end();
+      bool candidate_ready = false;
+      double candidate_rank = 0.0;
+      for (int queue_id : buffer.active_row_queues) {
+        auto& queue = buffer.row_queues[queue_id];
+        auto head = buffer.row_queue_head(queue_id);
+        // A blocked row is blocked for all of its requests
+        if (is_blocked && is_blocked(*head)) {
+          continue;
+        }
+
+        bool ready = m_ctrl->update_row_queue_command(buffer, queue_id);
+
+        auto best = head;
+        double best_rank = get_class_rank(head->qos_class);
+        for (auto next = buffer.row_queue_next(head); next != buffer.end(); next = buffer.row_queue_next(next)) {
+          double rank = get_class_rank(next->qos_class);
+          if (rank < best_rank) {
+            best = next;
+            best_rank = rank;
+          }
+        }
+        best->command = queue.command;
+
+        if (candidate == buffer.end() || (ready && !candidate_ready)) {
+          candidate = best;
+          candidate_ready = ready;
+          candidate_rank = best_rank;
+        } else if (ready == candidate_ready) {
+          if (best_rank < candidate_rank || (best_rank == candidate_rank && 
+              (best->arrive < candidate->arrive || (best->arrive == candidate->arrive && best.seq() < candidate.seq())))) {
+            candidate = best;
+            candidate_rank = best_rank;
+          }
+        }
+      }
+      return candidate;
+    };
+};
+
+}       // namespace Ramulator
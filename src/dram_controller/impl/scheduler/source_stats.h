@@ -0,0 +1,81 @@
+#ifndef     RAMULATOR_CONTROLLER_SCHEDULER_SOURCE_STATS_H
+#define     RAMULATOR_CONTROLLER_SCHEDULER_SOURCE_STATS_H
+
+#include <map>
+
+#include "base/base.h"
+#include "dram/dram.h"
+#include "dram_controller/controller.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Per-source (e.g., per-core) bandwidth and slowdown statistics of an application-aware scheduler
+ * @details
+ * A read or write from the frontend is recorded when its column command is issued. The slowdown of a source is
+ * estimated as its average memory latency (from arriving at the controller to departing) over its average service
+ * latency (from issuing its first command to departing), i.e., how much waiting behind the other buffered requests
+ * stretches its accesses (1 means that its requests never wait).
+ * 
+ */
+class SourceServiceStats {
+  private:
+    IDRAMController* m_ctrl = nullptr;
+    IDRAM* m_dram = nullptr;
+    int m_access_bytes = -1;
+
+    std::map<int, size_t> m_total_latency;
+    std::map<int, size_t> m_total_service_latency;
+
+    std::map<int, size_t> s_num_served_requests;
+    std::map<int, float> s_bandwidth;
+    std::map<int, float> s_slowdown;
+
+  public:
+    void init(Implementation* impl) {
+      impl->register_stat(s_num_served_requests).name("num_served_requests_per_source");
+      impl->register_stat(s_bandwidth).name("bandwidth_per_source").desc("GB/s");
+      impl->register_stat(s_slowdown).name("slowdown_per_source");
+    };
+
+    void setup(IDRAMController* ctrl) {
+      m_ctrl = ctrl;
+      m_dram = ctrl->m_dram;
+      m_access_bytes = m_dram->m_internal_prefetch_size * m_dram->m_channel_width / 8;
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) {
+      if (!request_found || !m_dram->m_command_meta(req_it->command).is_accessing || req_it->arrive == -1) {
+        return;
+      }
+      bool is_read = req_it->type_id == Request::Type::Read;
+      if (!is_read && req_it->type_id != Request::Type::Write) {
+        return;
+      }
+
+      Clk_t clk = m_ctrl->get_clk();
+      Clk_t issue = req_it->issue == -1 ? clk : req_it->issue;
+      Clk_t depart = clk + (is_read ? m_dram->m_read_latency : m_dram->m_write_latency);
+      s_num_served_requests[req_it->source_id]++;
+      m_total_latency[req_it->source_id] += depart - req_it->arrive;
+      m_total_service_latency[req_it->source_id] += depart - issue;
+    };
+
+    void finalize() {
+      Clk_t clk = m_ctrl->get_clk();
+      int tCK_ps = m_dram->m_timing_vals("tCK_ps");
+      for (const auto& [source_id, num_reqs] : s_num_served_requests) {
+        if (clk > 0) {
+          // Bytes per picosecond * 1000 = GB/s
+          s_bandwidth[source_id] = 1000.0f * num_reqs * m_access_bytes / (clk * tCK_ps);
+        }
+        if (m_total_service_latency[source_id] > 0) {
+          s_slowdown[source_id] = (float) m_total_latency[source_id] / m_total_service_latency[source_id];
+        }
+      }
+    };
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_CONTROLLER_SCHEDULER_SOURCE_STATS_H
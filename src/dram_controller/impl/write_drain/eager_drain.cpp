@@ -0,0 +1,92 @@
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/write_drain_policy.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Watermark-based write drains plus eager writebacks while there are no reads
+ * @details
+ * A drain that starts because the write buffer is above the high watermark ends at the low watermark, as with the
+ * default policy. In addition, once the read buffer has been empty for idle_threshold cycles, the buffered writes are
+ * written back eagerly to keep the write buffer low for later bursts of reads. An eager drain gives way to reads as
+ * soon as one arrives (unless the write buffer is above the high watermark), so it only uses otherwise idle cycles.
+ * 
+ */
+class EagerDrain : public IWriteDrainPolicy, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IWriteDrainPolicy, EagerDrain, "Eager", "Watermark write drains plus eager writebacks in idle time.")
+  private:
+    IDRAMController* m_ctrl;
+
+    float m_wr_low_watermark;
+    float m_wr_high_watermark;
+    Clk_t m_idle_threshold = -1;
+
+    bool m_is_eager = false;          // Whether the current drain is an eager one
+    Clk_t m_reads_empty_clk = -1;     // The cycle since which the read buffer is empty (-1 if it is not)
+    bool m_has_writes = false;        // Whether the write buffer had writes the last time the mode was decided
+
+    size_t s_num_eager_drains = 0;
+    size_t s_num_preempted_drains = 0;
+
+  public:
+    void init() override {
+      m_wr_low_watermark =  param<float>("wr_low_watermark").desc("Threshold for switching back to read mode.").default_val(0.2f);
+      m_wr_high_watermark = param<float>("wr_high_watermark").desc("Threshold for switching to write mode.").default_val(0.8f);
+      m_idle_threshold = param<Clk_t>("idle_threshold").desc("Number of cycles without reads after which writes are written back eagerly.").default_val(16);
+      if (m_idle_threshold < 0) {
+        throw ConfigurationError("The idle threshold of the eager write drain cannot be negative!");
+      }
+
+      register_stat(s_num_eager_drains).name("num_eager_drains");
+      register_stat(s_num_preempted_drains).name("num_preempted_drains").desc("Eager drains ended by an arriving read");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_ctrl = cast_parent<IDRAMController>();
+    };
+
+    bool is_write_mode(bool is_write_mode, ReqBuffer& read_buffer, ReqBuffer& write_buffer) override {
+      Clk_t clk = m_ctrl->get_clk();
+      if (read_buffer.size()) {
+        m_reads_empty_clk = -1;
+      } else if (m_reads_empty_clk == -1) {
+        m_reads_empty_clk = clk;
+      }
+      m_has_writes = write_buffer.size();
+      bool is_above_high = write_buffer.size() > m_wr_high_watermark * write_buffer.max_size;
+
+      if (!is_write_mode) {
+        if (is_above_high) {
+          m_is_eager = false;
+          return true;
+        }
+        if (m_has_writes && m_reads_empty_clk != -1 && clk - m_reads_empty_clk >= m_idle_threshold) {
+          m_is_eager = true;
+          s_num_eager_drains++;
+          return true;
+        }
+        return false;
+      }
+
+      if (m_is_eager) {
+        if (read_buffer.size() && !is_above_high) {
+          s_num_preempted_drains++;
+          return false;
+        }
+        // A drain that reaches the high watermark is no longer eager
+        m_is_eager = !is_above_high;
+        return true;
+      }
+      return !((write_buffer.size() < m_wr_low_watermark * write_buffer.max_size) && read_buffer.size() != 0);
+    };
+
+    Clk_t get_next_event_clk() override {
+      if (m_has_writes && m_reads_empty_clk != -1) {
+        return std::max(m_reads_empty_clk + m_idle_threshold, m_ctrl->get_clk() + 1);
+      }
+      return no_event_clk;
+    };
+};
+
+}       // namespace Ramulator
@@ -0,0 +1,77 @@
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/write_drain_policy.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Watermark-based write drains that serve at least a minimum number of writes once started
+ * @details
+ * The controller switches to write mode once the write buffer is above the high watermark (or there are no reads),
+ * and back to read mode once it is below the low watermark and reads are waiting, as the default policy does.
+ * However, a drain only ends after min_batch_size writes are served (or the write buffer is empty), so that
+ * the read/write turnaround is amortized over a batch of writes instead of being paid for one or two writes.
+ * 
+ */
+class MinBatchDrain : public IWriteDrainPolicy, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IWriteDrainPolicy, MinBatchDrain, "MinBatch", "Watermark write drains with a minimum batch size.")
+  private:
+    IDRAM* m_dram;
+
+    float m_wr_low_watermark;
+    float m_wr_high_watermark;
+    int m_min_batch_size = -1;
+
+    int m_num_drained_writes = 0;   // Number of writes served in the current drain
+    bool m_is_extended = false;     // Whether the current drain continued past the low watermark
+
+    size_t s_num_extended_drains = 0;
+
+  public:
+    void init() override {
+      m_wr_low_watermark =  param<float>("wr_low_watermark").desc("Threshold for switching back to read mode.").default_val(0.2f);
+      m_wr_high_watermark = param<float>("wr_high_watermark").desc("Threshold for switching to write mode.").default_val(0.8f);
+      m_min_batch_size = param<int>("min_batch_size").desc("Minimum number of writes served in a drain before switching back to reads.").default_val(16);
+      if (m_min_batch_size < 0) {
+        throw ConfigurationError("The minimum drain batch size cannot be negative!");
+      }
+
+      register_stat(s_num_extended_drains).name("num_extended_drains").desc("Drains that continued past the low watermark to fill the minimum batch");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_dram = cast_parent<IDRAMController>()->m_dram;
+    };
+
+    bool is_write_mode(bool is_write_mode, ReqBuffer& read_buffer, ReqBuffer& write_buffer) override {
+      if (!is_write_mode) {
+        if ((write_buffer.size() > m_wr_high_watermark * write_buffer.max_size) || read_buffer.size() == 0) {
+          m_num_drained_writes = 0;
+          m_is_extended = false;
+          return true;
+        }
+        return false;
+      }
+
+      if ((write_buffer.size() < m_wr_low_watermark * write_buffer.max_size) && read_buffer.size() != 0) {
+        if (m_num_drained_writes < m_min_batch_size && write_buffer.size() != 0) {
+          if (!m_is_extended) {
+            s_num_extended_drains++;
+            m_is_extended = true;
+          }
+          return true;
+        }
+        return false;
+      }
+      return true;
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      if (request_found && req_it->type_id == Request::Type::Write && req_it->arrive != -1 &&
+          m_dram->m_command_meta(req_it->command).is_accessing) {
+        m_num_drained_writes++;
+      }
+    };
+};
+
+}       // namespace Ramulator
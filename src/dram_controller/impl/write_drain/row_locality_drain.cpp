@@ -0,0 +1,128 @@
+#include <vector>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/write_drain_policy.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Watermark-based write drains that favour row-buffer locality when picking the writes to serve
+ * @details
+ * The controller switches between read and write mode on the watermarks, as the default policy does. During a
+ * drain, a ready write that hits an open row is served first (oldest first). Otherwise, the ready write whose row
+ * has the most buffered writes is served, so that every activation is amortized over as many writes as possible.
+ * A write never precharges a bank whose open row still has buffered writes.
+ * 
+ */
+class RowLocalityDrain : public IWriteDrainPolicy, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IWriteDrainPolicy, RowLocalityDrain, "RowLocality", "Watermark write drains that favour row hits.")
+  private:
+    IDRAM* m_dram;
+
+    float m_wr_low_watermark;
+    float m_wr_high_watermark;
+
+    std::vector<ReqBuffer::iterator> m_hit_heads;     // Oldest writes of the rows that are open (per decision)
+
+    size_t s_num_row_hit_picks = 0;
+    size_t s_num_batched_row_picks = 0;
+
+  public:
+    void init() override {
+      m_wr_low_watermark =  param<float>("wr_low_watermark").desc("Threshold for switching back to read mode.").default_val(0.2f);
+      m_wr_high_watermark = param<float>("wr_high_watermark").desc("Threshold for switching to write mode.").default_val(0.8f);
+
+      register_stat(s_num_row_hit_picks).name("num_row_hit_picks");
+      register_stat(s_num_batched_row_picks).name("num_batched_row_picks").desc("Picks of the row with the most buffered writes");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_dram = cast_parent<IDRAMController>()->m_dram;
+    };
+
+    bool is_write_mode(bool is_write_mode, ReqBuffer& read_buffer, ReqBuffer& write_buffer) override {
+      if (!is_write_mode) {
+        return (write_buffer.size() > m_wr_high_watermark * write_buffer.max_size) || read_buffer.size() == 0;
+      } else {
+        return !((write_buffer.size() < m_wr_low_watermark * write_buffer.max_size) && read_buffer.size() != 0);
+      }
+    };
+
+    bool get_best_write(ReqBuffer& write_buffer, const std::function<bool(const Request&)>& is_blocked, ReqBuffer::iterator& req_it) override {
+      if (!write_buffer.is_row_indexed()) {
+        return false;
+      }
+
+      // 1. The oldest ready row hit
+      m_hit_heads.clear();
+      auto best = write_buffer.end();
+      for (int queue_id : write_buffer.active_row_queues) {
+        auto head = write_buffer.row_queue_head(queue_id);
+        if ((is_blocked && is_blocked(*head)) || !m_dram->check_rowbuffer_hit(head->final_command, head->addr_vec)) {
+          continue;
+        }
+        m_hit_heads.push_back(head);
+        head->command = m_dram->get_preq_command(head->final_command, head->addr_vec);
+        if (m_dram->check_ready(head->command, head->addr_vec) && (best == write_buffer.end() || is_older(head, best))) {
+          best = head;
+        }
+      }
+      if (best != write_buffer.end()) {
+        req_it = best;
+        s_num_row_hit_picks++;
+        return true;
+      }
+
+      // 2. The ready write to the row with the most buffered writes that does not close a row still needed
+      size_t best_num_writes = 0;
+      for (int queue_id : write_buffer.active_row_queues) {
+        auto head = write_buffer.row_queue_head(queue_id);
+        if ((is_blocked && is_blocked(*head)) || m_dram->check_rowbuffer_hit(head->final_command, head->addr_vec)) {
+          continue;
+        }
+        head->command = m_dram->get_preq_command(head->final_command, head->addr_vec);
+        if (!m_dram->check_ready(head->command, head->addr_vec) || closes_needed_row(head)) {
+          continue;
+        }
+
+        size_t num_writes = 0;
+        for (auto next = head; next != write_buffer.end(); next = write_buffer.row_queue_next(next)) {
+          num_writes++;
+        }
+        if (num_writes > best_num_writes || (num_writes == best_num_writes && is_older(head, best))) {
+          best = head;
+          best_num_writes = num_writes;
+        }
+      }
+      if (best != write_buffer.end()) {
+        req_it = best;
+        s_num_batched_row_picks++;
+        return true;
+      }
+
+      // Nothing can be issued now, so let the scheduler decide
+      return false;
+    };
+
+  private:
+    bool is_older(ReqBuffer::iterator req1, ReqBuffer::iterator req2) const {
+      return req1->arrive < req2->arrive || (req1->arrive == req2->arrive && req1.seq() < req2.seq());
+    };
+
+    bool closes_needed_row(ReqBuffer::iterator req_it) const {
+      if (!m_dram->m_command_meta(req_it->command).is_closing) {
+        return false;
+      }
+      // The closing command covers every bank below its scope (e.g., PREA closes all banks of a rank)
+      int scope = m_dram->m_command_scopes(req_it->command);
+      for (auto hit_it : m_hit_heads) {
+        if (hit_it->addr_vec.same_prefix(req_it->addr_vec, scope + 1)) {
+          return true;
+        }
+      }
+      return false;
+    };
+};
+
+}       // namespace Ramulator
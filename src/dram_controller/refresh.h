@@ -14,6 +14,18 @@ class IRefreshManager {
 
   public:
     virtual void tick() = 0;
+
+    /**
+     * @brief    Returns the next cycle at which the refresh manager will issue a refresh (-1 if unknown).
+     *
+     */
+    virtual Clk_t get_next_event_clk() { return -1; };
+
+    /**
+     * @brief    Advances the refresh manager by num_cycles cycles without issuing any refresh.
+     *
+     */
+    virtual void fast_forward(Clk_t num_cycles) {};
 };
 
 }        // namespace Ramulator
@@ -0,0 +1,50 @@
+#ifndef     RAMULATOR_CONTROLLER_ROW_POLICY_H
+#define     RAMULATOR_CONTROLLER_ROW_POLICY_H
+
+#include <vector>
+#include <string>
+#include <functional>
+
+#include "base/base.h"
+
+
+namespace Ramulator {
+
+class IRowPolicy {
+  RAMULATOR_REGISTER_INTERFACE(IRowPolicy, "RowPolicy", "Row-Buffer Management Policy Interface.");
+
+  public:
+    /**
+     * @brief    Decides whether the final command (e.g., RD) of the request should close its row (e.g., RDA instead).
+     * @details
+     * The controller keeps the row open regardless if another buffered request still hits it.
+     * 
+     */
+    virtual bool should_close_row(const Request& req) = 0;
+
+    /**
+     * @brief    Observes every command issued by the controller.
+     * 
+     */
+    virtual void update(int command, const AddrVec_t& addr_vec) {};
+
+    /**
+     * @brief    Proposes an open row to close with a speculative PRE in a cycle in which no request can be served.
+     * @details
+     * The policy should only propose rows for which can_precharge returns true (i.e., no buffered request hits the row
+     * and the PRE can be issued now). Returns false if there is no row to close.
+     * 
+     */
+    virtual bool get_idle_precharge(AddrVec_t& addr_vec, const std::function<bool(const AddrVec_t&)>& can_precharge) { return false; };
+
+    /**
+     * @brief    Returns the next cycle at which the policy might propose a speculative PRE (-1 if unknown).
+     *
+     */
+    virtual Clk_t get_next_event_clk() { return no_event_clk; };
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_CONTROLLER_ROW_POLICY_H
\ No newline at end of file
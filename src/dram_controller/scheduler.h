@@ -2,6 +2,7 @@
 #define RAMULATOR_CONTROLLER_SCHEDULER_H
 
 #include <vector>
+#include <functional>
 
 #include <spdlog/spdlog.h>
 #include <yaml-cpp/yaml.h>
@@ -15,7 +16,17 @@ class IScheduler {
   public:
     virtual ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) = 0;
 
-    virtual ReqBuffer::iterator get_best_request(ReqBuffer& buffer) = 0;
+    /**
+     * @brief    Returns the best request in the buffer, skipping the requests for which is_blocked (if set) returns true
+     * 
+     */
+    virtual ReqBuffer::iterator get_best_request(ReqBuffer& buffer, const std::function<bool(const Request&)>& is_blocked) = 0;
+
+    /**
+     * @brief    Lets the scheduler observe the request (if any) the controller issues a command for at this cycle
+     * 
+     */
+    virtual void update(bool request_found, ReqBuffer::iterator& req_it) {};
 };
 
 }       // namespace Ramulator
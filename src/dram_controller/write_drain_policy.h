@@ -0,0 +1,49 @@
+#ifndef     RAMULATOR_CONTROLLER_WRITE_DRAIN_POLICY_H
+#define     RAMULATOR_CONTROLLER_WRITE_DRAIN_POLICY_H
+
+#include <vector>
+#include <string>
+#include <functional>
+
+#include "base/base.h"
+
+
+namespace Ramulator {
+
+class IWriteDrainPolicy {
+  RAMULATOR_REGISTER_INTERFACE(IWriteDrainPolicy, "WriteDrainPolicy", "Read/Write Mode Switching (Write Drain) Policy Interface.");
+
+  public:
+    /**
+     * @brief    Decides whether the controller serves the write buffer (true) or the read buffer (false).
+     * @details
+     * Called whenever the controller looks for a demand request to serve, with the current mode.
+     * 
+     */
+    virtual bool is_write_mode(bool is_write_mode, ReqBuffer& read_buffer, ReqBuffer& write_buffer) = 0;
+
+    /**
+     * @brief    Picks the write to serve in write mode, skipping the requests for which is_blocked (if set) returns true.
+     * @details
+     * The prerequisite command of the chosen request should be set. Returns false to let the scheduler pick instead.
+     * 
+     */
+    virtual bool get_best_write(ReqBuffer& write_buffer, const std::function<bool(const Request&)>& is_blocked, ReqBuffer::iterator& req_it) { return false; };
+
+    /**
+     * @brief    Observes the request (if any) the controller issues a command for at this cycle.
+     * 
+     */
+    virtual void update(bool request_found, ReqBuffer::iterator& req_it) {};
+
+    /**
+     * @brief    Returns the next cycle at which the policy might change the mode on its own (-1 if unknown).
+     *
+     */
+    virtual Clk_t get_next_event_clk() { return no_event_clk; };
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_CONTROLLER_WRITE_DRAIN_POLICY_H
\ No newline at end of file
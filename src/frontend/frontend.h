@@ -47,6 +47,22 @@ class IFrontEnd : public Clocked<IFrontEnd>, public TopLevel<IFrontEnd> {
 
     int get_clock_ratio() { return m_clock_ratio; };
 
+    /**
+     * @brief    Returns the earliest frontend clock cycle at which ticking the frontend can change its state
+     *
+     * @details
+     * Used by the fast-forward mode of the simulation loop to skip idle cycles. Returns -1 if the frontend
+     * cannot tell (i.e., it must be ticked every cycle), or no_event_clk if it is waiting on the memory system.
+     *
+     */
+    virtual Clk_t get_next_event_clk() { return -1; };
+
+    /**
+     * @brief    Advances the frontend clock by num_cycles cycles in which nothing happens
+     *
+     */
+    virtual void fast_forward(Clk_t num_cycles) { m_clk += num_cycles; };
+
     /**
      * @brief    Receives memory requests from external sources (e.g., coming from a full system simulator like GEM5)
      * 
@@ -11,12 +11,21 @@ namespace Ramulator {
 class GEM5 : public IFrontEnd, public Implementation {
   RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, GEM5, "GEM5", "GEM5 frontend.")
 
+  private:
+    std::vector<int> m_qos_classes;   // The QoS class of the requests from each source (i.e., gem5 requestor)
+
   public:
-    void init() override { };
+    void init() override {
+      m_qos_classes = param<std::vector<int>>("qos_classes").desc("The QoS class of the requests from each source id (sources without an entry use class 0).").default_val(std::vector<int>());
+    };
     void tick() override { };
 
     bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, std::function<void(Request&)> callback) override {
-      return m_memory_system->send({addr, req_type_id, source_id, callback});
+      Request req(addr, req_type_id, source_id, callback);
+      if (source_id >= 0 && source_id < m_qos_classes.size()) {
+        req.qos_class = m_qos_classes[source_id];
+      }
+      return m_memory_system->send(req);
     }
 
   private:
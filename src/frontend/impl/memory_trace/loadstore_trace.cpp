@@ -22,6 +22,8 @@ class LoadStoreTrace : public IFrontEnd, public Implementation {
     size_t m_trace_length = 0;
     size_t m_curr_trace_idx = 0;
 
+    int m_qos_class = 0;
+
     size_t m_trace_count = 0;
 
     Logger_t m_logger;
@@ -30,6 +32,7 @@ class LoadStoreTrace : public IFrontEnd, public Implementation {
     void init() override {
       std::string trace_path_str = param<std::string>("path").desc("Path to the load store trace file.").required();
       m_clock_ratio = param<uint>("clock_ratio").required();
+      m_qos_class = param<int>("qos_class").desc("The QoS class of the requests of the trace.").default_val(0);
 
       m_logger = Logging::create_logger("LoadStoreTrace");
       m_logger->info("Loading trace file {} ...", trace_path_str);
@@ -40,7 +43,9 @@ class LoadStoreTrace : public IFrontEnd, public Implementation {
 
     void tick() override {
       const Trace& t = m_trace[m_curr_trace_idx];
-      bool request_sent = m_memory_system->send({t.addr, t.is_write ? Request::Type::Write : Request::Type::Read});
+      Request req(t.addr, t.is_write ? Request::Type::Write : Request::Type::Read);
+      req.qos_class = m_qos_class;
+      bool request_sent = m_memory_system->send(req);
       if (request_sent) {
         m_curr_trace_idx = (m_curr_trace_idx + 1) % m_trace_length;
         m_trace_count++;
@@ -22,12 +22,15 @@ class ReadWriteTrace : public IFrontEnd, public Implementation {
     size_t m_trace_length = 0;
     size_t m_curr_trace_idx = 0;
 
+    int m_qos_class = 0;
+
     Logger_t m_logger;
 
   public:
     void init() override {
       std::string trace_path_str = param<std::string>("path").desc("Path to the load store trace file.").required();
       m_clock_ratio = param<uint>("clock_ratio").required();
+      m_qos_class = param<int>("qos_class").desc("The QoS class of the requests of the trace.").default_val(0);
 
       m_logger = Logging::create_logger("ReadWriteTrace");
       m_logger->info("Loading trace file {} ...", trace_path_str);
@@ -38,7 +41,9 @@ class ReadWriteTrace : public IFrontEnd, public Implementation {
 
     void tick() override {
       const Trace& t = m_trace[m_curr_trace_idx];
-      m_memory_system->send({t.addr_vec, t.is_write ? Request::Type::Read : Request::Type::Write});
+      Request req(t.addr_vec, t.is_write ? Request::Type::Read : Request::Type::Write);
+      req.qos_class = m_qos_class;
+      m_memory_system->send(req);
       m_curr_trace_idx = (m_curr_trace_idx + 1) % m_trace_length;
     };
 
@@ -146,6 +146,7 @@ void SimpleO3Core::tick() {
     };
 
     Request load_request(m_load_addr, Request::Type::Read, m_id, m_callback);
+    load_request.qos_class = m_qos_class;
     if (!m_translation->translate(load_request)) {
       return;
     };
@@ -167,6 +168,7 @@ void SimpleO3Core::tick() {
   // Third, try to send the writeback to the LLC
   if (m_writeback_addr != -1) {
     Request writeback_request(m_writeback_addr, Request::Type::Write, m_id, m_callback);
+    writeback_request.qos_class = m_qos_class;
     if (!m_translation->translate(writeback_request)) {
       return;
     };
@@ -181,6 +183,14 @@ void SimpleO3Core::tick() {
   m_writeback_addr = inst.store_addr;      
 }
 
+Clk_t SimpleO3Core::get_next_event_clk() {
+  // With a full window and an unready oldest instruction, nothing can retire or be inserted until the memory responds
+  if (m_window.is_full() && !m_window.m_ready_list[m_window.m_tail_idx] && (m_num_bubbles > 0 || m_load_addr != -1)) {
+    return no_event_clk;
+  }
+  return m_clk + 1;
+}
+
 void SimpleO3Core::receive(Request& req) {
   m_window.set_ready(req.addr);
 
@@ -80,6 +80,7 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
 
   private:
     int m_id = -1;
+    int m_qos_class = 0;   // The QoS class of the requests of the core
 
     Trace m_trace;
     InstWindow m_window;
@@ -113,6 +114,12 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
      */
     void tick() override;
 
+    /**
+     * @brief   Returns the next cycle at which ticking the core makes progress, or no_event_clk if it is stalled on the memory.
+     * 
+     */
+    Clk_t get_next_event_clk();
+
     /**
      * @brief   Called when a request is served by the memory.
      * 
@@ -52,6 +52,18 @@ void SimpleO3LLC::tick() {
   }
 };
 
+Clk_t SimpleO3LLC::get_next_event_clk() {
+  Clk_t next_clk = no_event_clk;
+  for (const auto& [clk, req] : m_miss_list) {
+    next_clk = std::min(next_clk, clk);
+  }
+  for (const auto& [clk, req] : m_hit_list) {
+    next_clk = std::min(next_clk, clk);
+  }
+  // Misses that were rejected by the memory system are retried every cycle
+  return next_clk == no_event_clk ? next_clk : std::max(next_clk, m_clk + 1);
+};
+
 bool SimpleO3LLC::send(Request req) {
   CacheSet_t& set = get_set(req.addr);
 
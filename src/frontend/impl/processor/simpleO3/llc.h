@@ -76,6 +76,7 @@ class SimpleO3LLC : public Clocked<SimpleO3LLC> {
     void connect_memory_system(IMemorySystem* memory_system) { m_memory_system = memory_system; };
     
     void tick();
+    Clk_t get_next_event_clk();
     bool send(Request req);
     void receive(Request& req);
 
@@ -1,6 +1,7 @@
 #include <functional>
 
 #include "base/utils.h"
+#include "base/exception.h"
 #include "frontend/frontend.h"
 #include "translation/translation.h"
 #include "frontend/impl/processor/simpleO3/core.h"
@@ -34,6 +35,10 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
 
       int ipc   = param<int>("ipc").desc("IPC of the SimpleO3 core.").default_val(4);
       int depth = param<int>("inst_window_depth").desc("Instruction window size of the SimpleO3 core.").default_val(128);
+      std::vector<int> qos_classes = param<std::vector<int>>("qos_classes").desc("The QoS class of the memory requests of each core.").default_val(std::vector<int>(m_num_cores, 0));
+      if (qos_classes.size() != m_num_cores) {
+        throw ConfigurationError("The number of QoS classes ({}) does not match the number of cores ({})!", qos_classes.size(), m_num_cores);
+      }
 
       // LLC params
       int llc_latency           = param<int>("llc_latency").desc("Aggregated latency of the LLC.").default_val(47);
@@ -57,6 +62,7 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       for (int id = 0; id < m_num_cores; id++) {
         SimpleO3Core* core = new SimpleO3Core(id, ipc, depth, m_num_expected_insts, trace_list[id], m_translation, m_llc);
         core->m_callback = [this](Request& req){return this->receive(req);} ;
+        core->m_qos_class = qos_classes[id];
         m_cores.push_back(core);
       }
 
@@ -91,6 +97,24 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       }
     }
 
+    Clk_t get_next_event_clk() override {
+      // Wake up for the heartbeat message as well
+      Clk_t next_clk = (m_clk / 10000000 + 1) * 10000000;
+      next_clk = std::min(next_clk, m_llc->get_next_event_clk());
+      for (auto core : m_cores) {
+        next_clk = std::min(next_clk, core->get_next_event_clk());
+      }
+      return next_clk;
+    };
+
+    void fast_forward(Clk_t num_cycles) override {
+      m_clk += num_cycles;
+      m_llc->m_clk += num_cycles;
+      for (auto core : m_cores) {
+        core->m_clk += num_cycles;
+      }
+    };
+
     void receive(Request& req) {
       m_llc->receive(req);
 
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <limits>
 
 #include <argparse/argparse.hpp>
 #include <spdlog/spdlog.h>
@@ -20,6 +21,9 @@ int main(int argc, char* argv[]) {
   program.add_argument("-p", "--param").metavar("KEY=VALUE")
     .append()
     .help("Specify parameter to override in the configuration file. Repeat this option to change multiple parameters.");
+  program.add_argument("--fast_forward")
+    .default_value(false).implicit_value(true)
+    .help("Skip the cycles in which neither the frontend nor the memory system has any work to do.");
 
   try {
     program.parse_args(argc, argv);
@@ -97,8 +101,28 @@ int main(int argc, char* argv[]) {
 
   int tick_mult = frontend_tick * mem_tick;
 
+  // In fast-forward mode, idle memory ticks are only accounted for (and applied lazily before the frontend
+  // can send new requests), and iterations in which neither side has any work to do are skipped altogether.
+  bool fast_forward = program.get<bool>("--fast_forward");
+  Ramulator::Clk_t num_skipped_mem_ticks = 0;
+  auto catch_up_memory_system = [&]() {
+    if (num_skipped_mem_ticks) {
+      memory_system->fast_forward(num_skipped_mem_ticks);
+      num_skipped_mem_ticks = 0;
+    }
+  };
+
+  // The n-th tick of a component that ticks every "ratio" iterations happens at iteration (n-1)*ratio
+  auto get_event_iter = [](Ramulator::Clk_t next_clk, int ratio) -> uint64_t {
+    if (next_clk == -1) {
+      return 0;
+    }
+    return next_clk == Ramulator::no_event_clk ? std::numeric_limits<uint64_t>::max() : (next_clk - 1) * ratio;
+  };
+
   for (uint64_t i = 0;; i++) {
     if (((i % tick_mult) % mem_tick) == 0) {
+      catch_up_memory_system();
       frontend->tick();
     }
 
@@ -107,9 +131,28 @@ int main(int argc, char* argv[]) {
     }
 
     if ((i % tick_mult) % frontend_tick == 0) {
-      memory_system->tick();
+      if (fast_forward && i < get_event_iter(memory_system->get_next_event_clk(), frontend_tick)) {
+        num_skipped_mem_ticks++;
+      } else {
+        catch_up_memory_system();
+        memory_system->tick();
+      }
+    }
+
+    if (fast_forward) {
+      Ramulator::Clk_t frontend_next_clk = frontend->get_next_event_clk();
+      if (frontend_next_clk == -1 || get_event_iter(frontend_next_clk, mem_tick) <= i + 1) {
+        continue;
+      }
+      uint64_t next_i = std::min(get_event_iter(frontend_next_clk, mem_tick), get_event_iter(memory_system->get_next_event_clk(), frontend_tick));
+      if (next_i > i + 1 && next_i != std::numeric_limits<uint64_t>::max()) {
+        frontend->fast_forward((next_i - 1) / mem_tick - i / mem_tick);
+        num_skipped_mem_ticks += (next_i - 1) / frontend_tick - i / frontend_tick;
+        i = next_i - 1;
+      }
     }
   }
+  catch_up_memory_system();
 
   // Finalize the simulation. Recursively print all statistics from all components
   frontend->finalize();
@@ -1,3 +1,9 @@
+#include <thread>
+#include <barrier>
+#include <atomic>
+#include <memory>
+#include <exception>
+
 #include "memory_system/memory_system.h"
 #include "translation/translation.h"
 #include "dram_controller/controller.h"
@@ -15,10 +21,24 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
     IAddrMapper*  m_addr_mapper;
     std::vector<IDRAMController*> m_controllers;
 
+    // Parallel ticking of the channel controllers
+    int m_num_threads = 1;
+    std::vector<std::thread> m_workers;
+    std::unique_ptr<std::barrier<>> m_tick_start;
+    std::unique_ptr<std::barrier<>> m_tick_done;
+    std::atomic<bool> m_stop_workers = false;
+    std::vector<std::exception_ptr> m_worker_errors;
+    std::vector<std::vector<Request>> m_completed_reqs;    // Per-channel requests whose callbacks are deferred to the end of the batch
+    Clk_t m_num_deferred_ticks = 0;   // Number of cycles since the controllers (and channels) were last synchronized
+    Clk_t m_sync_clk = 0;             // The cycle at which the deferred ticks must be run (no callback can happen before it)
+
+    Logger_t m_logger;
+
   public:
     int s_num_read_requests = 0;
     int s_num_write_requests = 0;
     int s_num_other_requests = 0;
+    size_t s_num_tick_batches = 0;
 
 
   public:
@@ -38,19 +58,70 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
       }
 
       m_clock_ratio = param<uint>("clock_ratio").required();
+      m_num_threads = param<int>("num_threads").desc("Number of threads that tick the channel controllers in parallel (1 = serial).").default_val(1);
+
+      m_logger = Logging::create_logger("GenericDRAMSystem");
+      if (m_num_threads > 1 && m_config["Controller"] && m_config["Controller"]["plugins"]) {
+        // Some plugins (e.g., RRS, Hydra) modify components shared by all channels
+        m_logger->warn("Controller plugins are not thread-safe, ticking the channels serially.");
+        m_num_threads = 1;
+      }
+      m_num_threads = std::clamp(m_num_threads, 1, num_channels);
 
       register_stat(m_clk).name("memory_system_cycles");
       register_stat(s_num_read_requests).name("total_num_read_requests");
       register_stat(s_num_write_requests).name("total_num_write_requests");
       register_stat(s_num_other_requests).name("total_num_other_requests");
+      if (m_num_threads > 1) {
+        register_stat(s_num_tick_batches).name("num_tick_batches").desc("Number of times the channel threads synchronized");
+      }
     };
 
-    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override { }
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      if (m_num_threads > 1) {
+        m_completed_reqs.resize(m_controllers.size());
+        m_worker_errors.resize(m_num_threads);
+        m_tick_start = std::make_unique<std::barrier<>>(m_num_threads);
+        m_tick_done = std::make_unique<std::barrier<>>(m_num_threads);
+        m_dram->enable_channel_clocks(m_controllers.size());
+        // The simulation thread itself works as worker 0
+        for (int worker_id = 1; worker_id < m_num_threads; worker_id++) {
+          m_workers.emplace_back(&GenericDRAMSystem::worker_loop, this, worker_id);
+        }
+      }
+    }
+
+    ~GenericDRAMSystem() {
+      if (m_workers.size()) {
+        m_stop_workers = true;
+        m_tick_start->arrive_and_wait();
+        for (auto& worker : m_workers) {
+          worker.join();
+        }
+      }
+    }
 
     bool send(Request req) override {
       m_addr_mapper->apply(req);
       int channel_id = req.addr_vec[0];
+
+      if (m_workers.size()) {
+        // The controller must see the request at the current cycle. The other channels can stay behind, and
+        // catching up a single channel cannot call any callback as the sync cycle has not been reached yet.
+        tick_channel_to_clk(channel_id);
+        if (req.callback) {
+          // Callbacks run on the simulation thread, in channel order, after all controllers are ticked
+          req.callback = [this, callback = req.callback](Request& completed_req) {
+            m_completed_reqs[completed_req.addr_vec[0]].push_back(completed_req);
+            m_completed_reqs[completed_req.addr_vec[0]].back().callback = callback;
+          };
+        }
+      }
       bool is_success = m_controllers[channel_id]->send(req);
+      if (m_workers.size()) {
+        // e.g., a forwarded read departs at the next cycle
+        update_sync_clk(m_controllers[channel_id]);
+      }
 
       if (is_success) {
         switch (req.type_id) {
@@ -74,10 +145,57 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
     
     void tick() override {
       m_clk++;
-      m_dram->tick();
+
+      if (!m_workers.size()) {
+        m_dram->tick();
+        for (auto controller : m_controllers) {
+          controller->tick();
+        }
+        return;
+      }
+
+      // Channels do not share any controller or device state, and a completed request can only affect the
+      // frontend, so the controllers only need to synchronize when a callback can happen (or a request arrives).
+      m_num_deferred_ticks++;
+      if (m_clk >= m_sync_clk) {
+        run_deferred_ticks();
+      }
+    };
+
+    Clk_t get_next_event_clk() override {
+      if (m_num_deferred_ticks) {
+        return -1;
+      }
+
+      Clk_t next_clk = no_event_clk;
       for (auto controller : m_controllers) {
-        controller->tick();
+        Clk_t ctrl_next_clk = controller->get_next_event_clk();
+        if (ctrl_next_clk == -1) {
+          return -1;
+        }
+        next_clk = std::min(next_clk, ctrl_next_clk);
+      }
+      return next_clk;
+    };
+
+    void fast_forward(Clk_t num_cycles) override {
+      run_deferred_ticks();
+      m_clk += num_cycles;
+      m_dram->fast_forward(num_cycles);
+      for (auto controller : m_controllers) {
+        controller->fast_forward(num_cycles);
       }
+      if (m_workers.size()) {
+        m_sync_clk = no_event_clk;
+        for (auto controller : m_controllers) {
+          update_sync_clk(controller);
+        }
+      }
+    };
+
+    void finalize() override {
+      run_deferred_ticks();
+      IMemorySystem::finalize();
     };
 
     float get_tCK() override {
@@ -87,6 +205,81 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
     // const SpecDef& get_supported_requests() override {
     //   return m_dram->m_requests;
     // };
+
+  private:
+    /**
+     * @brief    Ticks the controllers (and their channels) through the deferred cycles in parallel and calls the callbacks
+     *
+     */
+    void run_deferred_ticks() {
+      if (!m_num_deferred_ticks) {
+        return;
+      }
+
+      m_tick_start->arrive_and_wait();
+      tick_controllers(0);
+      m_tick_done->arrive_and_wait();
+      // All channels are at the memory system clock again
+      m_dram->sync_channel_clocks();
+      m_num_deferred_ticks = 0;
+      s_num_tick_batches++;
+
+      for (auto& error : m_worker_errors) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+
+      m_sync_clk = no_event_clk;
+      for (auto controller : m_controllers) {
+        update_sync_clk(controller);
+      }
+
+      // Requests sent by the callbacks lower the sync cycle again
+      for (auto& completed_reqs : m_completed_reqs) {
+        for (auto& req : completed_reqs) {
+          req.callback(req);
+        }
+        completed_reqs.clear();
+      }
+    };
+
+    void update_sync_clk(IDRAMController* controller) {
+      Clk_t callback_clk = controller->get_next_callback_clk();
+      if (callback_clk == -1) {
+        callback_clk = m_clk + 1;
+      }
+      m_sync_clk = std::min(m_sync_clk, callback_clk);
+    };
+
+    void worker_loop(int worker_id) {
+      while (true) {
+        m_tick_start->arrive_and_wait();
+        if (m_stop_workers) {
+          return;
+        }
+        tick_controllers(worker_id);
+        m_tick_done->arrive_and_wait();
+      }
+    };
+
+    void tick_controllers(int worker_id) {
+      try {
+        for (int i = worker_id; i < m_controllers.size(); i += m_num_threads) {
+          tick_channel_to_clk(i);
+        }
+      } catch (...) {
+        m_worker_errors[worker_id] = std::current_exception();
+      }
+    };
+
+    void tick_channel_to_clk(int channel_id) {
+      IDRAMController* controller = m_controllers[channel_id];
+      while (controller->get_clk() < m_clk) {
+        m_dram->tick_channel(channel_id);
+        controller->tick();
+      }
+    };
 };
   
 }   // namespace 
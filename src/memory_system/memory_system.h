@@ -57,6 +57,21 @@ class IMemorySystem : public TopLevel<IMemorySystem> {
      */
     virtual void tick() = 0;
 
+    /**
+     * @brief    Returns the earliest memory clock cycle at which ticking the memory system can change its state
+     *
+     * @details
+     * Returns -1 if the memory system cannot tell (i.e., it must be ticked every cycle).
+     *
+     */
+    virtual Clk_t get_next_event_clk() { return -1; };
+
+    /**
+     * @brief    Advances the memory system by num_cycles idle cycles without ticking it
+     *
+     */
+    virtual void fast_forward(Clk_t num_cycles) {};
+
     /**
      * @brief    Returns 
      * 